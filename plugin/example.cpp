@@ -35,12 +35,6 @@
 
 void EpiHiperPluginInit()
 {
-  for (const CTransmission & Transmission : CModel::GetTransmissions())
-    {
-      CLogger::info("EpiHiperPlugin: Setting custom method for transmission '{}'.", Transmission.getId());
-      Transmission.setCustomMethod(&EpiHiperPlugin::transmission_propensity);
-    }
-
   for (const CHealthState & HealthState : CModel::GetStates())
     {
       CLogger::info("EpiHiperPlugin: Setting custom method for health-state '{}'.", HealthState.getId());
@@ -55,14 +49,15 @@ void EpiHiperPluginInit()
 
   CLogger::info("EpiHiperPlugin: Setting custom method for incrementing tick.");
   CSimulation::setCustomMethod(&EpiHiperPlugin::increment_tick);
+
+  // The batch method takes precedence over the transmissions' per edge methods which are therefore not set.
+  CLogger::info("EpiHiperPlugin: Setting custom batch method for transmission propensities.");
+  CModel::SetCustomMethod(&EpiHiperPlugin::transmission_propensities);
 }
 
-// static 
-double EpiHiperPlugin::transmission_propensity(const CTransmission * pTransmission, const CEdge * pEdge)
+unsigned int EpiHiperPluginABIVersion()
 {
-  // ρ(P, P', Τi,j,k) = (| contactTime(P, P') ∩ [tn, tn + Δtn] |) × contactWeight(P, P') × σ(P, Χi) × ι(P',Χk) × ω(Τi,j,k)
-  return pEdge->duration * pEdge->weight * pEdge->pTarget->susceptibility
-         * pEdge->pSource->infectivity * pTransmission->getTransmissibility();
+  return CCustomMethodType::ABIVersion;
 }
 
 // static 
@@ -99,3 +94,18 @@ bool EpiHiperPlugin::increment_tick(int tick, bool init)
 {
   return true;
 }
+
+// static 
+void EpiHiperPlugin::transmission_propensities(const CCustomMethodType::transmission_batch & batch)
+{
+  // ρ(P, P', Τi,j,k) = (| contactTime(P, P') ∩ [tn, tn + Δtn] |) × contactWeight(P, P') × σ(P, Χi) × ι(P',Χk) × ω(Τi,j,k)
+  double Susceptibility = batch.pTarget->susceptibility;
+
+  // The gathered arrays allow the loop to be vectorized. Propensities of edges without transmission are ignored.
+  for (size_t i = 0; i < batch.size; ++i)
+    batch.pPropensities[i] = batch.pDurations[i] * batch.pWeights[i] * Susceptibility * batch.pInfectivities[i];
+
+  for (size_t i = 0; i < batch.size; ++i)
+    if (batch.pTransmissions[i] != NULL)
+      batch.pPropensities[i] *= batch.pTransmissions[i]->getTransmissibility();
+}
@@ -28,6 +28,7 @@
 extern "C"
 {
   void EpiHiperPluginInit();
+  unsigned int EpiHiperPluginABIVersion();
 }
 
 class CTransmission;
@@ -36,12 +37,17 @@ class CHealthState;
 class CProgression;
 class CNode;
 
+namespace CCustomMethodType
+{
+  struct transmission_batch;
+}
+
 struct EpiHiperPlugin
 {
-  static double transmission_propensity(const CTransmission * pTransmission, const CEdge * pEdge);
   static const CProgression * state_progression(const CHealthState * pHealthState, const CNode * pNode);
   static unsigned int progression_dwell_time(const CProgression * pProgression, const CNode * pNode);
   static bool increment_tick(int tick, bool init);
+  static void transmission_propensities(const CCustomMethodType::transmission_batch & batch);
 };
 
 #endif // PLUGIN_EXAMPLE_H_
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include "actions/CActionDefinition.h"
 #include "actions/CNodeAction.h"
 #include "actions/CEdgeAction.h"
+#include "diseaseModel/CModel.h"
 #include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "network/CEdge.h"
@@ -119,6 +120,9 @@ bool CActionQueue::processCurrentActions()
       for (; it != end; it.next())
         success &= it->execute();
 
+      // Progressions deferred while the actions were executed must be scheduled before pending actions are counted.
+      CModel::ProcessStateChanges();
+
       delete pActions;
 
       CCommunicate::barrierRMA();
@@ -173,7 +177,7 @@ void CActionQueue::addRemoteAction(const size_t & actionId, const CNode * pNode)
           {
             RemoteActions.write(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
             RemoteActions << 'N';
-            RemoteActions.write(reinterpret_cast< const char * >(&pNode->id), sizeof(size_t));
+            CNode::writePid(RemoteActions, pNode->id);
           }
         }
       catch (...)
@@ -206,14 +210,20 @@ void CActionQueue::addRemoteAction(const size_t & actionId, const CEdge * pEdge)
 
   if (index < 0)
     {
+      // The edge is identified by target, source, location, and its occurrence among identical edges
+      size_t LocationId = CNetwork::locationId(pEdge);
+      size_t Occurrence = CNetwork::occurrence(pEdge);
+
       try
         {
 #pragma omp critical (add_remote_action)
           {
             RemoteActions.write(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
             RemoteActions << 'E';
-            RemoteActions.write(reinterpret_cast< const char * >(&pEdge->targetId), sizeof(size_t));
-            RemoteActions.write(reinterpret_cast< const char * >(&pEdge->sourceId), sizeof(size_t));
+            CNode::writePid(RemoteActions, pEdge->targetId);
+            CNode::writePid(RemoteActions, pEdge->sourceId);
+            RemoteActions.write(reinterpret_cast< const char * >(&LocationId), sizeof(size_t));
+            RemoteActions.write(reinterpret_cast< const char * >(&Occurrence), sizeof(size_t));
           }
         }
       catch (...)
@@ -314,7 +324,7 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
         break;
 
       size_t NodeId;
-      is.read(reinterpret_cast< char * >(&NodeId), sizeof(size_t));
+      CNode::readPid(is, NodeId);
 
       if (is.fail())
         break;
@@ -354,11 +364,21 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
         case 'E':
           {
             size_t SourceId;
-            is.read(reinterpret_cast< char * >(&SourceId), sizeof(size_t));
+            CNode::readPid(is, SourceId);
+            if (is.fail())
+              break;
+
+            size_t LocationId;
+            is.read(reinterpret_cast< char * >(&LocationId), sizeof(size_t));
+            if (is.fail())
+              break;
+
+            size_t Occurrence;
+            is.read(reinterpret_cast< char * >(&Occurrence), sizeof(size_t));
             if (is.fail())
               break;
 
-            CEdge * pEdge = (CNetwork::Context.beginThread() + Index)->lookupEdge(NodeId, SourceId);
+            CEdge * pEdge = (CNetwork::Context.beginThread() + Index)->lookupEdge(NodeId, SourceId, LocationId, Occurrence);
 
             if (pEdge != NULL
                 && pActionDefinition != NULL)
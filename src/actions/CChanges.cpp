@@ -40,14 +40,14 @@
 void CChanges::init()
 {
   Context.init();
-  Context.Master().pDefaultOutput = new std::stringstream;
+  Context.Master().pDefaultOutput = new CFormatBuffer(1 << 16);
 
   Changes * pIt = Context.beginThread();
   Changes * pEnd = Context.endThread();
 
   for (; pIt != pEnd; ++pIt)
     if (Context.isThread(pIt))
-      pIt->pDefaultOutput = new std::stringstream;
+      pIt->pDefaultOutput = new CFormatBuffer(1 << 16);
 }
 
 // static
@@ -83,16 +83,42 @@ void CChanges::incrementTick()
 // static
 void CChanges::reset()
 {
+  // Only the recorded nodes need to be reset.
+  for (const CNode * pNode : Context.Master().Nodes)
+    pNode->changed = false;
+
+  Context.Master().Nodes.clear();
+
 #pragma omp parallel
   {
-    CNode * it = CNetwork::Context.Active().beginNode();
-    CNode * end = CNetwork::Context.Active().endNode();
+    Changes & Active = Context.Active();
+
+    if (Context.isThread(&Active))
+      {
+        for (const CNode * pNode : Active.Nodes)
+          pNode->changed = false;
 
-    for (; it != end; ++it)
-      it->changed = false;
+        Active.Nodes.clear();
+      }
   }
 }
 
+// static
+std::vector< const CChanges::ChangedNodes * > CChanges::getChangedNodes()
+{
+  std::vector< const ChangedNodes * > Changed;
+  Changed.push_back(&Context.Master().Nodes);
+
+  Changes * pIt = Context.beginThread();
+  Changes * pEnd = Context.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Context.isThread(pIt))
+      Changed.push_back(&pIt->Nodes);
+
+  return Changed;
+}
+
 // static
 void CChanges::initDefaultOutput()
 {
@@ -147,8 +173,7 @@ CCommunicate::ErrorCode CChanges::writeDefaultOutputData()
 
       for (; pIt != pEnd && out.good(); ++pIt)
         {
-          out << pIt->pDefaultOutput->str();
-          pIt->pDefaultOutput->str("");
+          pIt->pDefaultOutput->flush(out);
         }
     }
 
@@ -176,20 +201,18 @@ CCommunicate::ErrorCode CChanges::determineNodesRequested()
   std::map< size_t, CNode * >::const_iterator it = RemoteNodes.begin();
   std::map< size_t, CNode * >::const_iterator end = RemoteNodes.end();
 
-  size_t * pBuffer = RemoteNodes.size() > 0 ? new size_t[RemoteNodes.size()] : NULL;
-  size_t * pId = pBuffer;
+  std::ostringstream Buffer;
 
-  for (; it != end; ++it, ++pId)
+  for (; it != end; ++it)
     {
       // ENABLE_TRACE(CLogger::trace("CChanges::determineNodesRequested: node '{}'.", it->first););
-      *pId = it->first;
+      CNode::writePid(Buffer, it->first);
     }
 
-  CCommunicate::Receive Receive(&CChanges::receiveNodesRequested);
-  CCommunicate::roundRobin(pBuffer, RemoteNodes.size() * sizeof(size_t), &Receive);
+  std::string Ids = Buffer.str();
 
-  if (pBuffer != NULL)
-    delete[] pBuffer;
+  CCommunicate::Receive Receive(&CChanges::receiveNodesRequested);
+  CCommunicate::roundRobin(Ids.empty() ? NULL : Ids.c_str(), Ids.size(), &Receive);
 
   return CCommunicate::ErrorCode::Success;
 }
@@ -199,6 +222,10 @@ CCommunicate::ErrorCode CChanges::sendNodesRequested(std::ostream & os, int rece
 {
   size_t Count = 0;
 
+  // The receiver reads the nodes from shared memory
+  if (CNetwork::Context.Master().isSharedRank(receiver))
+    return CCommunicate::ErrorCode::Success;
+
 #pragma omp parallel shared(os) reduction(+: Count)
   {
     CNode * it = CNetwork::Context.Active().beginNode();
@@ -256,7 +283,7 @@ CCommunicate::ErrorCode CChanges::receiveNodesRequested(std::istream & is, int s
 
   while (true)
     {
-      is.read(reinterpret_cast< char * >(&id), sizeof(size_t));
+      CNode::readPid(is, id);
 
       if (is.fail())
         break;
@@ -35,6 +35,7 @@
 #include <sstream>
 #include <set>
 #include <map>
+#include <vector>
 
 #include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
@@ -42,6 +43,7 @@
 #include "network/CEdge.h"
 #include "diseaseModel/CHealthState.h"
 #include "utilities/CMetadata.h"
+#include "utilities/CFormatBuffer.h"
 
 class CChanges
 {
@@ -62,10 +64,16 @@ public:
   static void incrementTick();
   static void reset();
 
+  typedef std::vector< const CNode * > ChangedNodes;
+
+  // The local nodes changed by the master and each thread since the last reset
+  static std::vector< const ChangedNodes * > getChangedNodes();
+
 private:
   struct Changes
   {
-    std::stringstream *pDefaultOutput;
+    CFormatBuffer *pDefaultOutput;
+    ChangedNodes Nodes;
   };
 
   static CContext< Changes > Context;
@@ -80,9 +88,14 @@ inline void CChanges::record(const CNode * pNode, const CMetadata & metadata)
     if (pNode == NULL)
       return;
 
-    pNode->changed = true;
     Changes & Active = Context.Active();
 
+    if (!pNode->changed)
+      {
+        pNode->changed = true;
+        Active.Nodes.push_back(pNode);
+      }
+
     if (metadata.getBool("StateChange"))
       {
         // "tick,pid,exit_state,contact_pid,[locationId]"
@@ -109,7 +122,7 @@ inline void CChanges::record(const CNode * pNode, const CMetadata & metadata)
               }
           }
 
-        (*Active.pDefaultOutput) << std::endl;
+        (*Active.pDefaultOutput) << '\n';
       }
   }
 
@@ -87,6 +87,8 @@ bool CCondition::isTrue(CConditionDefinition::BooleanOperationType operation, co
         break;
 
       case CConditionDefinition::BooleanOperationType::Or:
+        result = false;
+
         for (bool value : booleanVector)
           result |= value;
         break;
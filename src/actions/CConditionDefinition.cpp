@@ -43,7 +43,10 @@ CConditionDefinition::CConditionDefinition()
   , mValue(true)
   , mBooleanValues()
   , mValid(true)
-{}
+  , mProgram()
+{
+  compile();
+}
 
 CConditionDefinition::CConditionDefinition(const CConditionDefinition & src)
   : mType(src.mType)
@@ -53,7 +56,10 @@ CConditionDefinition::CConditionDefinition(const CConditionDefinition & src)
   , mValue(src.mValue)
   , mBooleanValues(src.mBooleanValues)
   , mValid(src.mValid)
-{}
+  , mProgram()
+{
+  compile();
+}
 
 CConditionDefinition::CConditionDefinition(const json_t * json)
   : mType(BooleanOperationType::__SIZE)
@@ -63,6 +69,7 @@ CConditionDefinition::CConditionDefinition(const json_t * json)
   , mValue(false)
   , mBooleanValues()
   , mValid(false)
+  , mProgram()
 {
   fromJSON(json);
 }
@@ -97,17 +104,17 @@ void CConditionDefinition::fromJSON(const json_t * json)
       mValue = true;
       mValid = true;
 
+      compile();
       return;
     }
 
-  if (valueFromJSON(json))
-    return;
-
-  if (comparisonFromJSON(json))
-    return;
-
-  if (operationFromJSON(json)) // also handles not
-    return;
+  if (valueFromJSON(json)
+      || comparisonFromJSON(json)
+      || operationFromJSON(json)) // also handles not
+    {
+      compile();
+      return;
+    }
 
   CLogger::error("Condition: Invalid. {}", CSimConfig::jsonToString(json));
 }
@@ -522,122 +529,115 @@ bool CConditionDefinition::comparisonFromJSON(const json_t * json)
 
 bool CConditionDefinition::isTrue() const
 {
-  switch (mType)
-    {
-    case BooleanOperationType::And:
-    case BooleanOperationType::Or:
-    case BooleanOperationType::Not:
-      {
-        std::vector< bool > Vector;
-        std::vector< CConditionDefinition >::const_iterator it = mBooleanValues.begin();
-        std::vector< CConditionDefinition >::const_iterator end = mBooleanValues.end();
+  const Instruction * pInstruction = mProgram.data();
 
-        for (; it != end; ++it)
-          Vector.push_back(it->isTrue());
+  return evaluate< void >(pInstruction, NULL);
+}
 
-        return CCondition::isTrue(mType, Vector);
-      }
-      break;
+bool CConditionDefinition::isTrue(const CNode * pNode) const
+{
+  const Instruction * pInstruction = mProgram.data();
 
-    case BooleanOperationType::Value:
-      return CCondition::isTrue(mValue);
-      break;
+  return evaluate(pInstruction, pNode);
+}
 
-    case BooleanOperationType::Comparison:
-      {
-        if (mComparison != ComparisonType::Within
-            && mComparison != ComparisonType::NotWithin)
-          return CCondition::isTrue(mComparison, mLeft.value(), mRight.value());
-        else
-          return CCondition::isTrue(mComparison, mLeft.value(), mRight.valueList());
-      }
-      break;
+bool CConditionDefinition::isTrue(const CEdge * pEdge) const
+{
+  const Instruction * pInstruction = mProgram.data();
 
-    case BooleanOperationType::__SIZE:
-      break;
-    }
+  return evaluate(pInstruction, pEdge);
+}
 
-  return true;
+void CConditionDefinition::compile()
+{
+  mProgram.clear();
+  compile(mProgram);
 }
 
-bool CConditionDefinition::isTrue(const CNode * pNode) const
+void CConditionDefinition::compile(std::vector< Instruction > & program) const
+{
+  size_t Index = program.size();
+  program.push_back(Instruction {mType, 0, this});
+
+  std::vector< CConditionDefinition >::const_iterator it = mBooleanValues.begin();
+  std::vector< CConditionDefinition >::const_iterator end = mBooleanValues.end();
+
+  for (; it != end; ++it)
+    it->compile(program);
+
+  program[Index].next = program.size();
+}
+
+template < class Element >
+bool CConditionDefinition::evaluate(const Instruction *& pInstruction, const Element * pElement) const
 {
-  switch (mType)
+  const Instruction & Current = *pInstruction++;
+  const Instruction * pNext = mProgram.data() + Current.next;
+  bool Result = true;
+
+  // Boolean operations stop evaluating their operands as soon as the result is known.
+  switch (Current.type)
     {
     case BooleanOperationType::And:
+      while (Result && pInstruction != pNext)
+        Result = evaluate(pInstruction, pElement);
+
+      break;
+
     case BooleanOperationType::Or:
-    case BooleanOperationType::Not:
-      {
-        std::vector< bool > Vector;
-        std::vector< CConditionDefinition >::const_iterator it = mBooleanValues.begin();
-        std::vector< CConditionDefinition >::const_iterator end = mBooleanValues.end();
+      Result = false;
 
-        for (; it != end; ++it)
-          Vector.push_back(it->isTrue(pNode));
+      while (!Result && pInstruction != pNext)
+        Result = evaluate(pInstruction, pElement);
 
-        return CCondition::isTrue(mType, Vector);
-      }
+      break;
+
+    case BooleanOperationType::Not:
+      Result = !evaluate(pInstruction, pElement);
       break;
 
     case BooleanOperationType::Value:
-      return CCondition::isTrue(mValue);
+      Result = CCondition::isTrue(Current.pDefinition->mValue);
       break;
 
     case BooleanOperationType::Comparison:
-      {
-        if (mComparison != ComparisonType::Within
-            && mComparison != ComparisonType::NotWithin)
-          return CCondition::isTrue(mComparison, mLeft.value(pNode), mRight.value(pNode));
-        else
-          return CCondition::isTrue(mComparison, mLeft.value(pNode), mRight.valueList());
-      }
+      Result = Current.pDefinition->compare(pElement);
       break;
 
     case BooleanOperationType::__SIZE:
       break;
     }
 
-  return true;
+  pInstruction = pNext;
+
+  return Result;
 }
 
-bool CConditionDefinition::isTrue(const CEdge * pEdge) const
+bool CConditionDefinition::compare(const void * /* pElement */) const
 {
-  switch (mType)
-    {
-    case BooleanOperationType::And:
-    case BooleanOperationType::Or:
-    case BooleanOperationType::Not:
-      {
-        std::vector< bool > Vector;
-        std::vector< CConditionDefinition >::const_iterator it = mBooleanValues.begin();
-        std::vector< CConditionDefinition >::const_iterator end = mBooleanValues.end();
-
-        for (; it != end; ++it)
-          Vector.push_back(it->isTrue(pEdge));
+  if (mComparison != ComparisonType::Within
+      && mComparison != ComparisonType::NotWithin)
+    return CCondition::isTrue(mComparison, mLeft.value(), mRight.value());
 
-        return CCondition::isTrue(mType, Vector);
-      }
-      break;
+  return CCondition::isTrue(mComparison, mLeft.value(), mRight.valueList());
+}
 
-    case BooleanOperationType::Value:
-      return CCondition::isTrue(mValue);
-      break;
+bool CConditionDefinition::compare(const CNode * pNode) const
+{
+  if (mComparison != ComparisonType::Within
+      && mComparison != ComparisonType::NotWithin)
+    return CCondition::isTrue(mComparison, mLeft.value(pNode), mRight.value(pNode));
 
-    case BooleanOperationType::Comparison:
-      {
-        if (mComparison != ComparisonType::Within
-            && mComparison != ComparisonType::NotWithin)
-          return CCondition::isTrue(mComparison, mLeft.value(pEdge), mRight.value(pEdge));
-        else
-          return CCondition::isTrue(mComparison, mLeft.value(pEdge), mRight.valueList());
-      }
-      break;
+  return CCondition::isTrue(mComparison, mLeft.value(pNode), mRight.valueList());
+}
 
-    case BooleanOperationType::__SIZE:
-      break;
-    }
+bool CConditionDefinition::compare(const CEdge * pEdge) const
+{
+  if (mComparison != ComparisonType::Within
+      && mComparison != ComparisonType::NotWithin)
+    return CCondition::isTrue(mComparison, mLeft.value(pEdge), mRight.value(pEdge));
 
-  return true;
+  return CCondition::isTrue(mComparison, mLeft.value(pEdge), mRight.valueList());
 }
 
 const bool & CConditionDefinition::isValid() const
@@ -78,6 +78,9 @@ public:
    */
   virtual ~CConditionDefinition();
 
+  // The compiled program refers to the condition tree and must not be copied by assignment
+  CConditionDefinition & operator = (const CConditionDefinition & rhs) = delete;
+
   virtual void fromJSON(const json_t * json);
 
   bool valueFromJSON(const json_t * json);
@@ -95,6 +98,30 @@ public:
   bool isTrue(const CEdge * pEdge) const;
 
 private:
+  /**
+   * A node of the condition tree in prefix order. The operands of a Boolean operation
+   * are the instructions up to next.
+   */
+  struct Instruction
+  {
+    BooleanOperationType type;
+    size_t next;
+    const CConditionDefinition * pDefinition;
+  };
+
+  void compile();
+
+  void compile(std::vector< Instruction > & program) const;
+
+  template < class Element > bool evaluate(const Instruction *& pInstruction, const Element * pElement) const;
+
+  // Comparison without a node or edge
+  bool compare(const void * pElement) const;
+
+  bool compare(const CNode * pNode) const;
+
+  bool compare(const CEdge * pEdge) const;
+
   BooleanOperationType mType;
   ComparisonType mComparison;
   CValueInstance mLeft;
@@ -102,6 +129,7 @@ private:
   bool mValue;
   std::vector< CConditionDefinition > mBooleanValues;
   bool mValid;
+  std::vector< Instruction > mProgram;
 };
 
 #endif /* SRC_ACTIONS_CCONDITIONDEFINITION_H_ */
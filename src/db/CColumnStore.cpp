@@ -0,0 +1,656 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <numeric>
+#include <cstring>
+#include <jansson.h>
+
+#include "db/CColumnStore.h"
+#include "db/CSchema.h"
+#include "db/CTable.h"
+#include "db/CField.h"
+#include "db/CFieldValue.h"
+#include "db/CFieldValueList.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "utilities/CSimConfig.h"
+#include "utilities/CDirEntry.h"
+#include "utilities/CLogger.h"
+
+namespace
+{
+// Fields may be enclosed in double quotes, in which case they may contain commas and quotes escaped as "".
+void splitCSV(const std::string & line, std::vector< std::string > & fields)
+{
+  fields.clear();
+
+  std::string::size_type End = line.size();
+
+  if (End > 0 && line[End - 1] == '\r')
+    --End;
+
+  std::string Field;
+  bool Quoted = false;
+
+  for (std::string::size_type i = 0; i < End; ++i)
+    {
+      char c = line[i];
+
+      if (Quoted)
+        {
+          if (c != '"')
+            Field += c;
+          else if (i + 1 < End && line[i + 1] == '"')
+            Field += line[++i];
+          else
+            Quoted = false;
+        }
+      else if (c == '"')
+        Quoted = true;
+      else if (c == ',')
+        {
+          fields.push_back(Field);
+          Field.clear();
+        }
+      else
+        Field += c;
+    }
+
+  fields.push_back(Field);
+}
+
+template < class value_type, class compare >
+void scan(const value_type * pValue, const value_type * pEnd, const value_type & constraint, char * pMatch)
+{
+  compare Compare;
+
+  for (; pValue != pEnd; ++pValue, ++pMatch)
+    *pMatch = Compare(*pValue, constraint);
+}
+
+template < class value_type >
+bool compare(const std::vector< value_type > & values, const size_t & first, const size_t & last, const value_type & constraint, const std::string & cmp, std::vector< char > & match)
+{
+  match.resize(last - first);
+
+  const value_type * pBegin = values.data() + first;
+  const value_type * pEnd = values.data() + last;
+
+  if (cmp == "=")
+    scan< value_type, std::equal_to< value_type > >(pBegin, pEnd, constraint, match.data());
+  else if (cmp == "<>")
+    scan< value_type, std::not_equal_to< value_type > >(pBegin, pEnd, constraint, match.data());
+  else if (cmp == "<")
+    scan< value_type, std::less< value_type > >(pBegin, pEnd, constraint, match.data());
+  else if (cmp == "<=")
+    scan< value_type, std::less_equal< value_type > >(pBegin, pEnd, constraint, match.data());
+  else if (cmp == ">")
+    scan< value_type, std::greater< value_type > >(pBegin, pEnd, constraint, match.data());
+  else if (cmp == ">=")
+    scan< value_type, std::greater_equal< value_type > >(pBegin, pEnd, constraint, match.data());
+  else
+    return false;
+
+  return true;
+}
+
+template < class value_type >
+void contains(const std::vector< value_type > & values, const size_t & first, const size_t & last, std::vector< value_type > & constraints, const bool & in, std::vector< char > & match)
+{
+  std::sort(constraints.begin(), constraints.end());
+  match.resize(last - first);
+
+  typename std::vector< value_type >::const_iterator it = values.begin() + first;
+  typename std::vector< value_type >::const_iterator end = values.begin() + last;
+  std::vector< char >::iterator itMatch = match.begin();
+
+  for (; it != end; ++it, ++itMatch)
+    *itMatch = (std::binary_search(constraints.begin(), constraints.end(), *it) == in);
+}
+
+template < class value_type >
+void appendDistinct(const std::vector< value_type > & values, const size_t & first, const std::vector< char > & match, CFieldValueList & result)
+{
+  std::vector< value_type > Selected;
+  std::vector< char >::const_iterator itMatch = match.begin();
+  std::vector< char >::const_iterator endMatch = match.end();
+  typename std::vector< value_type >::const_iterator it = values.begin() + first;
+
+  for (; itMatch != endMatch; ++itMatch, ++it)
+    if (*itMatch)
+      Selected.push_back(*it);
+
+  std::sort(Selected.begin(), Selected.end());
+  Selected.erase(std::unique(Selected.begin(), Selected.end()), Selected.end());
+
+  for (const value_type & Value : Selected)
+    result.append(CFieldValue(Value));
+}
+
+template < class value_type >
+void permute(std::vector< value_type > & values, const std::vector< size_t > & order)
+{
+  // Columns only hold the values of their own type
+  if (values.size() != order.size())
+    return;
+
+  std::vector< value_type > Permuted;
+  Permuted.reserve(order.size());
+
+  for (const size_t & Index : order)
+    Permuted.push_back(values[Index]);
+
+  values.swap(Permuted);
+}
+}
+
+// static
+CColumnStore CColumnStore::INSTANCE;
+
+// static
+bool CColumnStore::isEnabled()
+{
+  return CSimConfig::getDBConnection().embedded;
+}
+
+CColumnStore::CColumnStore()
+  : mTables()
+  , mLoaded(false)
+{}
+
+CColumnStore::~CColumnStore()
+{}
+
+void CColumnStore::load(const std::vector< std::string > & dataResources)
+{
+  mTables.clear();
+
+  std::vector< std::string >::const_iterator it = dataResources.begin();
+  std::vector< std::string >::const_iterator end = dataResources.end();
+
+  for (; it != end; ++it)
+    if (!loadResource(*it))
+      CLogger::error("CColumnStore: Failed to load '{}'.", *it);
+
+  mLoaded = true;
+}
+
+const bool & CColumnStore::isLoaded() const
+{
+  return mLoaded;
+}
+
+bool CColumnStore::loadResource(const std::string & dataResource)
+{
+  json_t * pRoot = CSimConfig::loadJsonPreamble(dataResource, JSON_DECODE_INT_AS_REAL);
+
+  if (pRoot == NULL)
+    return false;
+
+  std::string Name;
+  std::string Path;
+  json_t * pValue = json_object_get(pRoot, "name");
+
+  if (json_is_string(pValue))
+    Name = json_string_value(pValue);
+
+  pValue = json_object_get(pRoot, "path");
+
+  if (json_is_string(pValue))
+    Path = json_string_value(pValue);
+
+  json_decref(pRoot);
+
+  const CTable & SchemaTable = CSchema::INSTANCE.getTable(Name);
+
+  if (!SchemaTable.isValid())
+    {
+      CLogger::error("CColumnStore: Invalid table '{}'.", Name);
+      return false;
+    }
+
+  // The data follows the preamble or is located in the file given by path.
+  std::ifstream is(dataResource.c_str());
+  std::string Line;
+  std::getline(is, Line);
+  std::getline(is, Line);
+
+  if (is.fail() || Line.empty())
+    {
+      is.close();
+      is.clear();
+      is.open(CDirEntry::resolve(Path, dataResource).c_str());
+      std::getline(is, Line);
+    }
+
+  if (is.fail())
+    {
+      CLogger::error("CColumnStore: Missing data for table '{}'.", Name);
+      return false;
+    }
+
+  Table & Data = mTables[Name];
+  Data.rows = 0;
+  Data.columns.clear();
+
+  std::vector< std::string > Fields;
+  splitCSV(Line, Fields);
+
+  std::vector< Column * > Columns;
+  std::vector< std::map< std::string, size_t > > Dictionaries(Fields.size());
+
+  for (const std::string & Field : Fields)
+    {
+      const CField & SchemaField = SchemaTable.getField(Field);
+
+      if (SchemaField.isValid())
+        {
+          Column * pColumn = &Data.columns[Field];
+          pColumn->type = SchemaField.getType();
+          Columns.push_back(pColumn);
+        }
+      else
+        Columns.push_back(NULL);
+    }
+
+  const std::array< size_t, 2 > & Range = CNetwork::Context.Master().getTotalNodeRange();
+  std::vector< std::string >::const_iterator itPid = std::find(Fields.begin(), Fields.end(), "pid");
+  size_t PidIndex = itPid - Fields.begin();
+
+  while (std::getline(is, Line))
+    {
+      if (Line.empty())
+        continue;
+
+      splitCSV(Line, Fields);
+
+      if (Fields.size() != Columns.size())
+        {
+          CLogger::error("CColumnStore: Invalid row '{}' in table '{}'.", Data.rows + 1, Name);
+          return false;
+        }
+
+      // Only rows with a pid in the node range of the network are relevant.
+      if (PidIndex < Fields.size())
+        {
+          size_t Pid = strtoull(Fields[PidIndex].c_str(), NULL, 10);
+
+          if (Pid < Range[0] || Pid > Range[1])
+            continue;
+        }
+
+      for (size_t i = 0, imax = Fields.size(); i < imax; ++i)
+        {
+          Column * pColumn = Columns[i];
+
+          if (pColumn == NULL)
+            continue;
+
+          switch (pColumn->type)
+            {
+            case CValueInterface::Type::id:
+              pColumn->ids.push_back(strtoull(Fields[i].c_str(), NULL, 10));
+              break;
+
+            case CValueInterface::Type::integer:
+              pColumn->integers.push_back(strtol(Fields[i].c_str(), NULL, 10));
+              break;
+
+            case CValueInterface::Type::number:
+              pColumn->numbers.push_back(strtod(Fields[i].c_str(), NULL));
+              break;
+
+            case CValueInterface::Type::string:
+              {
+                std::map< std::string, size_t >::iterator found = Dictionaries[i].emplace(Fields[i], pColumn->dictionary.size()).first;
+
+                if (found->second == pColumn->dictionary.size())
+                  pColumn->dictionary.push_back(Fields[i]);
+
+                pColumn->ids.push_back(found->second);
+              }
+              break;
+
+            default:
+              break;
+            }
+        }
+
+      ++Data.rows;
+    }
+
+  // Sort the rows by pid so that the rows within a pid range are consecutive.
+  std::map< std::string, Column >::iterator found = Data.columns.find("pid");
+
+  if (found != Data.columns.end())
+    {
+      const std::vector< size_t > & Pids = found->second.ids;
+      std::vector< size_t > Order(Data.rows);
+      std::iota(Order.begin(), Order.end(), 0);
+      std::stable_sort(Order.begin(), Order.end(), [&Pids](const size_t & lhs, const size_t & rhs) {
+        return Pids[lhs] < Pids[rhs];
+      });
+
+      for (std::pair< const std::string, Column > & Column : Data.columns)
+        {
+          permute(Column.second.ids, Order);
+          permute(Column.second.integers, Order);
+          permute(Column.second.numbers, Order);
+        }
+    }
+
+  CLogger::info("CColumnStore: Loaded '{}' rows for table '{}'.", Data.rows, Name);
+
+  return true;
+}
+
+const CColumnStore::Column * CColumnStore::getColumn(const CTable & table, const CField & field) const
+{
+  std::map< std::string, Table >::const_iterator foundTable = mTables.find(table.getId());
+
+  if (foundTable == mTables.end())
+    {
+      CLogger::error("CColumnStore: No data for table '{}'.", table.getId());
+      return NULL;
+    }
+
+  std::map< std::string, Column >::const_iterator found = foundTable->second.columns.find(field.getId());
+
+  if (found == foundTable->second.columns.end())
+    {
+      CLogger::error("CColumnStore: No data for field '{}' in table '{}'.", field.getId(), table.getId());
+      return NULL;
+    }
+
+  return &found->second;
+}
+
+void CColumnStore::rowRange(const CTable & table, const bool & local, size_t & first, size_t & last) const
+{
+  std::map< std::string, Table >::const_iterator foundTable = mTables.find(table.getId());
+
+  first = 0;
+  last = 0;
+
+  if (foundTable == mTables.end())
+    return;
+
+  last = foundTable->second.rows;
+  std::map< std::string, Column >::const_iterator found = foundTable->second.columns.find("pid");
+
+  if (found == foundTable->second.columns.end())
+    return;
+
+  size_t Range[2];
+
+  if (local)
+    {
+      CNode * pBegin = CNetwork::Context.Active().beginNode();
+      CNode * pEnd = CNetwork::Context.Active().endNode();
+
+      if (pBegin == pEnd)
+        {
+          last = first;
+          return;
+        }
+
+      Range[0] = pBegin->id;
+      Range[1] = (pEnd - 1)->id;
+    }
+  else
+    {
+      Range[0] = CNetwork::Context.Master().getTotalNodeRange()[0];
+      Range[1] = CNetwork::Context.Master().getTotalNodeRange()[1];
+    }
+
+  const std::vector< size_t > & Pids = found->second.ids;
+  first = std::lower_bound(Pids.begin(), Pids.end(), Range[0]) - Pids.begin();
+  last = std::upper_bound(Pids.begin() + first, Pids.end(), Range[1]) - Pids.begin();
+}
+
+void CColumnStore::append(const Column & column, const size_t & first, const std::vector< char > & match, CFieldValueList & result) const
+{
+  switch (column.type)
+    {
+    case CValueInterface::Type::id:
+      appendDistinct(column.ids, first, match, result);
+      break;
+
+    case CValueInterface::Type::integer:
+      appendDistinct(column.integers, first, match, result);
+      break;
+
+    case CValueInterface::Type::number:
+      appendDistinct(column.numbers, first, match, result);
+      break;
+
+    case CValueInterface::Type::string:
+      {
+        std::vector< char > Used(column.dictionary.size(), false);
+        std::vector< char >::const_iterator itMatch = match.begin();
+        std::vector< char >::const_iterator endMatch = match.end();
+        std::vector< size_t >::const_iterator it = column.ids.begin() + first;
+
+        for (; itMatch != endMatch; ++itMatch, ++it)
+          if (*itMatch)
+            Used[*it] = true;
+
+        std::vector< std::string > Selected;
+
+        for (size_t i = 0, imax = Used.size(); i < imax; ++i)
+          if (Used[i])
+            Selected.push_back(column.dictionary[i]);
+
+        std::sort(Selected.begin(), Selected.end());
+
+        for (const std::string & Value : Selected)
+          result.append(CFieldValue(Value));
+      }
+      break;
+
+    default:
+      break;
+    }
+}
+
+bool CColumnStore::all(const CTable & table,
+                       const CField & resultField,
+                       CFieldValueList & result,
+                       const bool & local) const
+{
+  const Column * pResult = getColumn(table, resultField);
+
+  if (pResult == NULL)
+    return false;
+
+  size_t First, Last;
+  rowRange(table, local, First, Last);
+
+  append(*pResult, First, std::vector< char >(Last - First, true), result);
+
+  CLogger::debug("CColumnStore::all: '{}' returned '{}' rows.", table.getId(), result.size());
+
+  return true;
+}
+
+bool CColumnStore::in(const CTable & table,
+                      const CField & resultField,
+                      CFieldValueList & result,
+                      const bool & local,
+                      const CField & constraintField,
+                      const CValueList & constraints,
+                      const bool & in) const
+{
+  const Column * pResult = getColumn(table, resultField);
+  const Column * pConstraint = getColumn(table, constraintField);
+
+  if (pResult == NULL || pConstraint == NULL)
+    return false;
+
+  size_t First = 0;
+  size_t Last = 0;
+
+  // Consistent with the SQL backend only pid results are restricted to the range.
+  if (resultField.getId() == "pid")
+    rowRange(table, local, First, Last);
+  else
+    Last = mTables.find(table.getId())->second.rows;
+
+  std::vector< char > Match;
+
+  switch (pConstraint->type)
+    {
+    case CValueInterface::Type::id:
+      {
+        std::vector< size_t > Values;
+
+        for (const CValue & Value : constraints)
+          Values.push_back(Value.toId());
+
+        contains(pConstraint->ids, First, Last, Values, in, Match);
+      }
+      break;
+
+    case CValueInterface::Type::integer:
+      {
+        std::vector< int > Values;
+
+        for (const CValue & Value : constraints)
+          Values.push_back(Value.toInteger());
+
+        contains(pConstraint->integers, First, Last, Values, in, Match);
+      }
+      break;
+
+    case CValueInterface::Type::number:
+      {
+        std::vector< double > Values;
+
+        for (const CValue & Value : constraints)
+          Values.push_back(Value.toNumber());
+
+        contains(pConstraint->numbers, First, Last, Values, in, Match);
+      }
+      break;
+
+    case CValueInterface::Type::string:
+      {
+        // Strings are compared once per dictionary entry.
+        std::vector< char > Code(pConstraint->dictionary.size());
+
+        for (size_t i = 0, imax = Code.size(); i < imax; ++i)
+          Code[i] = (constraints.contains(CValue(pConstraint->dictionary[i])) == in);
+
+        Match.resize(Last - First);
+        std::vector< char >::iterator itMatch = Match.begin();
+        std::vector< size_t >::const_iterator it = pConstraint->ids.begin() + First;
+        std::vector< size_t >::const_iterator end = pConstraint->ids.begin() + Last;
+
+        for (; it != end; ++it, ++itMatch)
+          *itMatch = Code[*it];
+      }
+      break;
+
+    default:
+      CLogger::error("CColumnStore::in: Unsupported type for field '{}'.", constraintField.getId());
+      return false;
+    }
+
+  append(*pResult, First, Match, result);
+
+  CLogger::debug("CColumnStore::{}: '{}' returned '{}' rows.", in ?  "in" : "notIn", table.getId(), result.size());
+
+  return true;
+}
+
+bool CColumnStore::where(const CTable & table,
+                         const CField & resultField,
+                         CFieldValueList & result,
+                         const bool & local,
+                         const CField & constraintField,
+                         const CValueInterface & constraint,
+                         const std::string & cmp) const
+{
+  const Column * pResult = getColumn(table, resultField);
+  const Column * pConstraint = getColumn(table, constraintField);
+
+  if (pResult == NULL || pConstraint == NULL)
+    return false;
+
+  size_t First, Last;
+  rowRange(table, local, First, Last);
+
+  std::vector< char > Match;
+  bool success = true;
+
+  switch (pConstraint->type)
+    {
+    case CValueInterface::Type::id:
+      success = compare(pConstraint->ids, First, Last, constraint.toId(), cmp, Match);
+      break;
+
+    case CValueInterface::Type::integer:
+      success = compare(pConstraint->integers, First, Last, constraint.toInteger(), cmp, Match);
+      break;
+
+    case CValueInterface::Type::number:
+      success = compare(pConstraint->numbers, First, Last, constraint.toNumber(), cmp, Match);
+      break;
+
+    case CValueInterface::Type::string:
+      {
+        // Strings are compared once per dictionary entry.
+        std::vector< char > Code;
+        success = compare(pConstraint->dictionary, 0, pConstraint->dictionary.size(), constraint.toString(), cmp, Code);
+
+        Match.resize(Last - First);
+        std::vector< char >::iterator itMatch = Match.begin();
+        std::vector< size_t >::const_iterator it = pConstraint->ids.begin() + First;
+        std::vector< size_t >::const_iterator end = pConstraint->ids.begin() + Last;
+
+        for (; it != end && success; ++it, ++itMatch)
+          *itMatch = Code[*it];
+      }
+      break;
+
+    default:
+      success = false;
+      break;
+    }
+
+  if (!success)
+    {
+      CLogger::error("CColumnStore::where: Unsupported comparison '{}' for field '{}'.", cmp, constraintField.getId());
+      return false;
+    }
+
+  append(*pResult, First, Match, result);
+
+  CLogger::debug("CColumnStore::where: '{}' returned '{}' rows.", table.getId(), result.size());
+
+  return true;
+}
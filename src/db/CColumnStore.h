@@ -0,0 +1,115 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_DB_CCOLUMNSTORE_H_
+#define SRC_DB_CCOLUMNSTORE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "math/CValueInterface.h"
+
+class CTable;
+class CField;
+class CValueList;
+class CFieldValueList;
+
+/**
+ * An in memory backend for the person trait database. The rows of the tables 
+ * are loaded from the person trait DB files (CSV data resources) and are kept 
+ * as typed columns sorted by pid. String columns are dictionary encoded. Queries
+ * are evaluated as scans over the rows within the requested pid range.
+ *
+ * Sets with global scope are evaluated by each process. Therefore every process 
+ * keeps all rows with a pid within the node range of the whole network, i.e., 
+ * the memory required per process is that of the network's person trait data.
+ */
+class CColumnStore
+{
+public:
+  static CColumnStore INSTANCE;
+
+  static bool isEnabled();
+
+  CColumnStore();
+
+  ~CColumnStore();
+
+  void load(const std::vector< std::string > & dataResources);
+
+  const bool & isLoaded() const;
+
+  bool all(const CTable & table,
+           const CField & resultField,
+           CFieldValueList & result,
+           const bool & local) const;
+
+  bool in(const CTable & table,
+          const CField & resultField,
+          CFieldValueList & result,
+          const bool & local,
+          const CField & constraintField,
+          const CValueList & constraints,
+          const bool & in) const;
+
+  bool where(const CTable & table,
+             const CField & resultField,
+             CFieldValueList & result,
+             const bool & local,
+             const CField & constraintField,
+             const CValueInterface & constraint,
+             const std::string & cmp) const;
+
+private:
+  struct Column
+  {
+    CValueInterface::Type type;
+
+    // Ids and the dictionary index of strings
+    std::vector< size_t > ids;
+    std::vector< int > integers;
+    std::vector< double > numbers;
+    std::vector< std::string > dictionary;
+  };
+
+  struct Table
+  {
+    size_t rows = 0;
+    std::map< std::string, Column > columns;
+  };
+
+  bool loadResource(const std::string & dataResource);
+
+  const Column * getColumn(const CTable & table, const CField & field) const;
+
+  void rowRange(const CTable & table, const bool & local, size_t & first, size_t & last) const;
+
+  void append(const Column & column, const size_t & first, const std::vector< char > & match, CFieldValueList & result) const;
+
+  std::map< std::string, Table > mTables;
+  bool mLoaded;
+};
+
+#endif /* SRC_DB_CCOLUMNSTORE_H_ */
@@ -40,12 +40,13 @@ void CConnection::setRequired(const bool & isRequired)
 // static
 void CConnection::init()
 {
-  if (pINSTANCE != NULL
-      || !required)
-    return;
-
   const CSimConfig::db_connection & dbConnection = CSimConfig::getDBConnection();
 
+  if (Pool.size() != 0
+      || !required
+      || dbConnection.embedded)
+    return;
+
   // postgresql://[user[:password]@][netloc][:port][,...][/dbname][?param1=value1&...]
   std::ostringstream URI;
   URI << "postgresql://";
@@ -63,10 +64,60 @@ void CConnection::init()
   URI << dbConnection.host <<"/" << dbConnection.name;
 
   URI << "?connect_timeout=" << dbConnection.connectionTimeout;
+
+  Pool.init();
+  Pool.Master() = connect(URI.str());
+
+  if (Pool.Master() == NULL)
+    return;
+
+  // Each thread queries its own slice of the data through its own connection. The master connection is only
+  // used outside of parallel regions and is therefore reused by the first thread.
+  shared = !dbConnection.connectionPerThread || Pool.size() == 1;
+
+  CConnection ** pIt = Pool.beginThread();
+  CConnection ** pEnd = Pool.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Pool.isThread(pIt))
+      *pIt = NULL;
+
+  for (pIt = Pool.beginThread(); pIt != pEnd && !shared; ++pIt)
+    if (Pool.isThread(pIt)
+        && pIt != Pool.beginThread())
+      {
+        *pIt = connect(URI.str(), true);
+
+        // If a thread connection fails all threads share the master connection.
+        if (*pIt == NULL)
+          {
+            CLogger::warn("CConnection: Failed to open a connection per thread, falling back to a shared connection.");
+            shared = true;
+          }
+      }
+
+  for (pIt = Pool.beginThread(); pIt != pEnd; ++pIt)
+    if (Pool.isThread(pIt))
+      {
+        if (shared
+            && *pIt != NULL
+            && *pIt != Pool.Master())
+          delete *pIt;
+
+        if (shared || pIt == Pool.beginThread())
+          *pIt = Pool.Master();
+      }
+}
+
+// static
+CConnection * CConnection::connect(const std::string & uri, const bool & optional)
+{
+  const CSimConfig::db_connection & dbConnection = CSimConfig::getDBConnection();
+  CConnection * pConnection = NULL;
   int Tries = dbConnection.connectionRetries + 1;
 
   while (Tries > 0
-         && pINSTANCE == NULL)
+         && pConnection == NULL)
     {
       if (dbConnection.connectionMaxDelay > 0)
         {
@@ -79,20 +130,22 @@ void CConnection::init()
 
       try
         {
-          pINSTANCE = new CConnection(URI.str());
+          pConnection = new CConnection(uri);
         }
 
       catch (const pqxx::pqxx_exception & e)
         {
-          clear();
-
           std::string Message = CLogger::sanitize(e.base().what());
 
           if ((Message.find("timeout expired") == std::string::npos
                && Message.find("Could not obtain client encoding") == std::string::npos)
               || Tries == 0)
             {
-              CLogger::error("{}", Message);
+              if (optional)
+                CLogger::warn("{}", Message);
+              else
+                CLogger::error("{}", Message);
+
               Tries = 0;
             } 
           else
@@ -101,29 +154,62 @@ void CConnection::init()
             }
         }
     }
+
+  return pConnection;
 }
 
 // static
 void CConnection::clear()
 {
-  if (pINSTANCE != NULL)
-    {
-      delete pINSTANCE;
-      pINSTANCE = NULL;
-    }
+  if (Pool.size() == 0)
+    return;
+
+  CConnection ** pIt = Pool.beginThread();
+  CConnection ** pEnd = Pool.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Pool.isThread(pIt)
+        && *pIt != Pool.Master()
+        && *pIt != NULL)
+      delete *pIt;
+
+  if (Pool.Master() != NULL)
+    delete Pool.Master();
+
+  Pool.release();
+  shared = true;
+}
+
+// static
+bool CConnection::isShared()
+{
+  return shared;
 }
 
 // static 
 std::string CConnection::quote(const std::string & str)
 {
-  if (pINSTANCE == NULL)
+  // The thread's own connection is used since the master connection may be busy with a query of the first thread.
+  if (Pool.size() == 0
+      || Pool.Active() == NULL)
     return "";
 
-  return pINSTANCE->mConnection.quote_name(str);
+  return Pool.Active()->mConnection.quote_name(str);
+}
+
+// static 
+void CConnection::prepare(const std::string & name, const std::string & definition)
+{
+  CConnection * pConnection = Pool.Active();
+
+  if (pConnection != NULL
+      && pConnection->mPrepared.insert(name).second)
+    pConnection->mConnection.prepare(name, definition);
 }
 
 CConnection::CConnection(const std::string & uri)
   : mConnection(uri)
+  , mPrepared()
 {}
 
 CConnection::~CConnection()
@@ -29,8 +29,11 @@
 # undef HAVE_SYS_TYPES_H
 #endif
 
+#include <set>
 #include <pqxx/pqxx>
 
+#include "utilities/CContext.h"
+
 class CConnection
 {
 public:
@@ -38,15 +41,26 @@ public:
   static void clear();
   template < class Type > static Type * work();
   static std::string quote(const std::string & str);
+
+  // Prepare the statement on the active connection unless this has already been done
+  static void prepare(const std::string & name, const std::string & definition);
   static void setRequired(const bool & required);
+
+  // True if the threads share a single connection, i.e., queries must be serialized
+  static bool isShared();
   
   virtual ~CConnection();
 
 private:
-  static CConnection * pINSTANCE;
+  // A failure to open an optional connection is only reported as a warning
+  static CConnection * connect(const std::string & uri, const bool & optional = false);
+
+  static CContext< CConnection * > Pool;
+  static bool shared;
   static bool required;
   CConnection(const std::string & uri = "");
   pqxx::connection mConnection;
+  std::set< std::string > mPrepared;
 };
 
 #include "utilities/CLogger.h"
@@ -54,14 +68,15 @@ private:
 template < class Type > 
 Type * CConnection::work()
 {
-  if (pINSTANCE == NULL)
+  if (Pool.size() == 0
+      || Pool.Active() == NULL)
     return NULL;
 
   Type * pWork = NULL;
 
   try
     {
-      pWork = new Type(pINSTANCE->mConnection);
+      pWork = new Type(Pool.Active()->mConnection);
     }
 
   catch (const std::exception & e)
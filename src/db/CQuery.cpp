@@ -23,8 +23,12 @@
 // END: Copyright 
 
 #include <sstream>
+#include <iomanip>
+#include <limits>
+#include <tuple>
 
 #include "db/CQuery.h"
+#include "db/CColumnStore.h"
 #include "db/CConnection.h"
 #include "db/CSchema.h"
 #include "db/CFieldValueList.h"
@@ -120,6 +124,18 @@ CContext< std::string > CQuery::LocalConstraint = CContext< std::string >();
 // static
 size_t CQuery::Limit = 100000;
 
+// static
+CQuery::Cache CQuery::Results = CQuery::Cache();
+
+// static
+const size_t CQuery::CopyThreshold = 1000;
+
+// static
+const size_t CQuery::CacheThreshold = 1000;
+
+// static
+std::map< std::string, CQuery::Statement > CQuery::Statements = std::map< std::string, CQuery::Statement >();
+
 // static
 void CQuery::init()
 {
@@ -134,6 +150,10 @@ void CQuery::init()
         std::ostringstream Query;
         Query << "pid BETWEEN " << CNetwork::Context.Master().getTotalNodeRange()[0] << " AND " << CNetwork::Context.Master().getTotalNodeRange()[1];
         GlobalConstraint = Query.str();
+
+        if (CColumnStore::isEnabled()
+            && !CColumnStore::INSTANCE.isLoaded())
+          CColumnStore::INSTANCE.load(CSimConfig::getPersonTraitDB());
       }
     }
 
@@ -151,25 +171,6 @@ void CQuery::init()
     }
 }
 
-// static
-std::string CQuery::limit(size_t & offset)
-{
-  if (Limit == 0)
-    {
-      return "";
-    }
-
-  std::ostringstream Query;
-  Query << " LIMIT " << Limit;
-
-  if (offset != 0)
-    Query << " OFFSET " << offset;
-
-  offset += Limit;
-
-  return Query.str();
-}
-
 // static
 bool CQuery::all(const std::string & table,
                  const std::string & resultField,
@@ -188,44 +189,24 @@ bool CQuery::all(const std::string & table,
   if (!ResultField.isValid())
     return false;
 
+  // The key must not depend on quoting since no connection exists for the embedded store.
+  std::ostringstream Key;
+  Key << "all " << table << "." << resultField << " " << (local ? LocalConstraint.Active() : GlobalConstraint);
+
+  if (lookup(Key.str(), "", result))
+    return true;
+
+  if (CColumnStore::isEnabled())
+    return store(Key.str(), "", result, CColumnStore::INSTANCE.all(Table, ResultField, result, local));
+
   std::ostringstream Query;
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table);
   Query << " WHERE " << (local ? LocalConstraint.Active() : GlobalConstraint);
   // std::cout << Query.str() << std::endl;
 
-  bool success = true;
-
-#pragma omp critical (sql_query)
-  {
-    pqxx::read_transaction * pWork = CConnection::work< pqxx::read_transaction >();
-
-    if (pWork == NULL)
-      success = false;
-    else
-      {
-        try
-          {
-            size_t Offset = 0;
-            while (toFieldValueList(ResultField, pWork->exec(Query.str() + limit(Offset)), result) == Limit
-                   && Limit != 0)
-              continue;
-
-            pWork->commit();
-          }
-
-        catch (const std::exception & e)
-          {
-            CLogger::error("CQuery::All: {}", CLogger::sanitize(e.what()));
-            success = false;
-          }
-
-          delete pWork;
-      }
-
-    CLogger::debug("CQuery::All: {} returned '{}' rows.", Query.str(), result.size());
-  }
+  bool success = execute("all", "", Query.str(), ResultField, result);
 
-  return success;
+  return store(Key.str(), "", result, success);
 }
 
 // static
@@ -295,53 +276,88 @@ bool CQuery::in(const std::string & table,
           }
     }
 
-  std::ostringstream Query;
-  
-  std::string TmpTableName = createTemporaryTable(constraintField, Query);
-  Query << "INSERT INTO " << CConnection::quote(TmpTableName) << " (" << CConnection::quote(constraintField) << ") VALUES (";
+  std::ostringstream Key;
+  Key << (in ? "in " : "notIn ") << table << "." << resultField << " " << constraintField << " " << (local ? LocalConstraint.Active() : GlobalConstraint);
 
-  bool FirstTime = true;
-  CFieldValueList::const_iterator it = constraints.begin();
-  CFieldValueList::const_iterator end = constraints.end();
+  // Large constraint lists are not cached since serializing them for the comparison and keeping
+  // a copy of the result costs about as much as executing the query.
+  const bool Cached = (constraints.size() <= CacheThreshold);
+  std::ostringstream Values;
 
-  for (; it != end; ++it)
+  if (Cached)
     {
-      if (FirstTime)
-        {
-          FirstTime = false;
-        }
-      else
-        {
-          Query << "), (";
-        }
+      Values << std::setprecision(std::numeric_limits< double >::max_digits10) << constraints;
+
+      if (lookup(Key.str(), Values.str(), result))
+        return true;
+    }
+
+  if (CColumnStore::isEnabled())
+    {
+      bool success = CColumnStore::INSTANCE.in(Table, ResultField, result, local, ConstraintField, constraints, in);
+
+      return Cached ? store(Key.str(), Values.str(), result, success) : success;
+    }
 
-      switch (constraints.getType())
+  std::ostringstream Prepare;
+  
+  std::string TmpTableName = createTemporaryTable(constraintField, Prepare);
+  const CValueList * pCopy = NULL;
+
+  // Large constraint lists are streamed to the server instead of being sent as literals which need to be parsed.
+  if (constraints.size() > CopyThreshold)
+    {
+      pCopy = &constraints;
+    }
+  else
+    {
+      Prepare << "INSERT INTO " << CConnection::quote(TmpTableName) << " (" << CConnection::quote(constraintField) << ") VALUES (";
+
+      bool FirstTime = true;
+      CFieldValueList::const_iterator it = constraints.begin();
+      CFieldValueList::const_iterator end = constraints.end();
+
+      for (; it != end; ++it)
         {
-        case CFieldValueList::Type::id:
-          Query << it->toId();
-          break;
-
-        case CFieldValueList::Type::string:
-          Query << "'" << it->toString() << "'";
-          break;
-
-        case CFieldValueList::Type::number:
-          Query << it->toNumber();
-          break;
-
-        case CFieldValueList::Type::integer:
-          Query << it->toInteger();
-          break;
-
-        case CFieldValueList::Type::boolean:
-        case CFieldValueList::Type::traitData:
-        case CFieldValueList::Type::traitValue:
-        case CFieldValueList::Type::__SIZE:
-          break;
+          if (FirstTime)
+            {
+              FirstTime = false;
+            }
+          else
+            {
+              Prepare << "), (";
+            }
+
+          switch (constraints.getType())
+            {
+            case CFieldValueList::Type::id:
+              Prepare << it->toId();
+              break;
+
+            case CFieldValueList::Type::string:
+              Prepare << "'" << it->toString() << "'";
+              break;
+
+            case CFieldValueList::Type::number:
+              Prepare << it->toNumber();
+              break;
+
+            case CFieldValueList::Type::integer:
+              Prepare << it->toInteger();
+              break;
+
+            case CFieldValueList::Type::boolean:
+            case CFieldValueList::Type::traitData:
+            case CFieldValueList::Type::traitValue:
+            case CFieldValueList::Type::__SIZE:
+              break;
+            }
         }
+
+      Prepare << "); ";
     }
 
-  Query << "); ";
+  std::ostringstream Query;
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table) << " AS l ";
   Query << (in ? "INNER JOIN " : "LEFT JOIN ") << CConnection::quote(TmpTableName) << " AS r "; 
   Query << "ON l." << CConnection::quote(constraintField) << " = r." << CConnection::quote(constraintField);
@@ -362,39 +378,9 @@ bool CQuery::in(const std::string & table,
 
   Query << " ORDER BY " << CConnection::quote(resultField);
 
-  bool success = true;
-
-#pragma omp critical (sql_query)
-  {
-    pqxx::work * pWork = CConnection::work< pqxx::work >();
-
-    if (pWork == NULL)
-      success = false;
-    else
-      {
-        try
-          {
-            size_t Offset = 0;
-            while (toFieldValueList(ResultField, pWork->exec(Query.str() + limit(Offset)), result) == Limit
-                   && Limit != 0)
-              continue;
-
-            pWork->commit();
-          }
+  bool success = execute(in ? "in" : "notIn", Prepare.str(), Query.str(), ResultField, result, TmpTableName, pCopy);
 
-        catch (const std::exception & e)
-          {
-            CLogger::error("CQuery::{}: {}", in ?  "in" : "notIn", CLogger::sanitize(e.what()));
-            success = false;
-          }
-
-        delete pWork;
-
-        CLogger::debug("CQuery::{}: {} returned '{}' rows.", in ?  "in" : "notIn", Query.str(), result.size());
-      }
-  }
-
-  return success;
+  return Cached ? store(Key.str(), Values.str(), result, success) : success;
 }
 
 // static
@@ -456,7 +442,43 @@ bool CQuery::where(const std::string & table,
       return false;
     }
 
+  std::ostringstream Key;
+  Key << "where " << table << "." << resultField << " " << constraintField << " " << cmp << " " << (local ? LocalConstraint.Active() : GlobalConstraint);
+
+  std::ostringstream Values;
+  Values << std::setprecision(std::numeric_limits< double >::max_digits10) << constraint;
+
+  if (lookup(Key.str(), Values.str(), result))
+    return true;
+
+  if (CColumnStore::isEnabled())
+    return store(Key.str(), Values.str(), result, CColumnStore::INSTANCE.where(Table, ResultField, result, local, ConstraintField, constraint, cmp));
+
+  // Id results are fetched through a statement prepared once per query shape. The constraint value is bound as parameter
+  // and pages are delimited by the last id returned.
+  if (ResultField.getType() == CFieldValueList::Type::id)
+    {
+      const Statement * pStatement = statement(Key.str());
+
+      if (pStatement == NULL)
+        {
+          std::ostringstream Definition;
+          Definition << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table) << " WHERE " << CConnection::quote(constraintField) << " " << cmp << " $1";
+          Definition << " AND " << (local ? LocalConstraint.Active() : GlobalConstraint);
+          Definition << " AND " << CConnection::quote(resultField) << " > $2";
+          Definition << " ORDER BY " << CConnection::quote(resultField);
+
+          if (Limit != 0)
+            Definition << " LIMIT " << Limit;
+
+          pStatement = statement(Key.str(), Definition.str());
+        }
+
+      return store(Key.str(), Values.str(), result, execute("where", *pStatement, Values.str(), ResultField, result));
+    }
+
   std::ostringstream Query;
+  Query << std::setprecision(std::numeric_limits< double >::max_digits10);
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table) << " WHERE " << CConnection::quote(constraintField) << " " << cmp << " ";
 
   switch (constraint.getType())
@@ -488,70 +510,274 @@ bool CQuery::where(const std::string & table,
   Query << " ORDER BY " << CConnection::quote(resultField);
   // std::cout << Query.str() << std::endl;
 
+  bool success = execute("where", "", Query.str(), ResultField, result);
+
+  return store(Key.str(), Values.str(), result, success);
+}
+
+// static 
+pqxx::result CQuery::sql(const std::string & sql)
+{
+  pqxx::result Result;
+
+  if (CConnection::isShared())
+    {
+#pragma omp critical (sql_query)
+      Result = exec(sql);
+    }
+  else
+    {
+      Result = exec(sql);
+    }
+
+  return Result;
+}
+
+// static 
+pqxx::result CQuery::exec(const std::string & sql)
+{
+  pqxx::result Result;
+  pqxx::read_transaction * pWork = CConnection::work< pqxx::read_transaction >();
+
+  if (pWork != NULL)
+    {
+      try
+        {
+          Result = pWork->exec(sql);
+          pWork->commit();
+        }
+
+      catch (const std::exception & e)
+        {
+          CLogger::error("CQuery::sql: {}", CLogger::sanitize(e.what()));
+        }
+
+      delete pWork;
+
+      CLogger::debug("CQuery::{}: {} returned '{}' rows.", "sql", sql, Result.size());
+    }
+
+  return Result;
+}
+
+// static 
+bool CQuery::execute(const std::string & context,
+                     const std::string & prepare,
+                     const std::string & query,
+                     const CField & field,
+                     CFieldValueList & result,
+                     const std::string & copyTable,
+                     const CValueList * pCopy)
+{
   bool success = true;
 
+  // Threads with their own connection query their slice concurrently.
+  if (CConnection::isShared())
+    {
 #pragma omp critical (sql_query)
-  {
-    pqxx::read_transaction * pWork = CConnection::work< pqxx::read_transaction >();
+      success = fetch(context, prepare, query, field, result, copyTable, pCopy);
+    }
+  else
+    {
+      success = fetch(context, prepare, query, field, result, copyTable, pCopy);
+    }
 
-    if (pWork == NULL)
-      success = false;
-    else
-      {
-        try
-          {
-            size_t Offset = 0;
-            while (toFieldValueList(ResultField, pWork->exec(Query.str() + limit(Offset)), result) == Limit
-                   && Limit != 0)
-              continue;
+  return success;
+}
 
-            pWork->commit();
-          }
+// static 
+bool CQuery::fetch(const std::string & context,
+                   const std::string & prepare,
+                   const std::string & query,
+                   const CField & field,
+                   CFieldValueList & result,
+                   const std::string & copyTable,
+                   const CValueList * pCopy)
+{
+  pqxx::transaction_base * pWork = NULL;
 
-        catch (const std::exception & e)
-          {
-            CLogger::error("CQuery::where: {}", CLogger::sanitize(e.what()));
-            success = false;
-          }
+  if (prepare.empty())
+    pWork = CConnection::work< pqxx::read_transaction >();
+  else
+    pWork = CConnection::work< pqxx::work >();
 
-        delete pWork;
+  if (pWork == NULL)
+    return false;
 
-        CLogger::debug("CQuery::where: {} returned '{}' rows.", Query.str(), result.size());
-      }
-  }
+  bool success = true;
+
+  try
+    {
+      if (!prepare.empty())
+        pWork->exec(prepare);
+
+      if (pCopy != NULL)
+        copy(*pWork, copyTable, *pCopy);
+
+      // The server side cursor pages through the result without the quadratic cost of LIMIT and OFFSET.
+      pqxx::stateless_cursor< pqxx::cursor_base::read_only, pqxx::cursor_base::owned > Cursor(*pWork, query, "epihiper_query", false);
+
+      if (Limit == 0)
+        {
+          toFieldValueList(field, Cursor.retrieve(0, Cursor.size()), result);
+        }
+      else
+        {
+          size_t Begin = 0;
+          pqxx::result Rows;
+
+          do
+            {
+              Rows = Cursor.retrieve(Begin, Begin + Limit);
+              toFieldValueList(field, Rows, result);
+              Begin += Limit;
+            }
+          while (Rows.size() == Limit);
+        }
+
+      pWork->commit();
+    }
+
+  catch (const std::exception & e)
+    {
+      CLogger::error("CQuery::{}: {}", context, CLogger::sanitize(e.what()));
+      success = false;
+    }
+
+  delete pWork;
+
+  CLogger::debug("CQuery::{}: {} returned '{}' rows.", context, query, result.size());
 
   return success;
 }
 
 // static 
-pqxx::result CQuery::sql(const std::string & sql)
+bool CQuery::execute(const std::string & context,
+                     const Statement & statement,
+                     const std::string & value,
+                     const CField & field,
+                     CFieldValueList & result)
 {
-  pqxx::result Result;
+  bool success = true;
 
+  if (CConnection::isShared())
+    {
 #pragma omp critical (sql_query)
+      success = fetch(context, statement, value, field, result);
+    }
+  else
+    {
+      success = fetch(context, statement, value, field, result);
+    }
+
+  return success;
+}
+
+// static 
+bool CQuery::fetch(const std::string & context,
+                   const Statement & statement,
+                   const std::string & value,
+                   const CField & field,
+                   CFieldValueList & result)
+{
+  pqxx::read_transaction * pWork = CConnection::work< pqxx::read_transaction >();
+
+  if (pWork == NULL)
+    return false;
+
+  bool success = true;
+
+  try
+    {
+      CConnection::prepare(statement.first, statement.second);
+
+      // Ids are non negative
+      long long Last = -1;
+      pqxx::result Rows;
+
+      do
+        {
+          Rows = pWork->exec_prepared(statement.first, value, Last);
+          toFieldValueList(field, Rows, result);
+
+          if (Rows.size() > 0)
+            Last = Rows[Rows.size() - 1][0].as< long long >();
+        }
+      while (Limit != 0 && Rows.size() == Limit);
+
+      pWork->commit();
+    }
+
+  catch (const std::exception & e)
+    {
+      CLogger::error("CQuery::{}: {}", context, CLogger::sanitize(e.what()));
+      success = false;
+    }
+
+  delete pWork;
+
+  CLogger::debug("CQuery::{}: {} ({}) returned '{}' rows.", context, statement.second, value, result.size());
+
+  return success;
+}
+
+// static 
+const CQuery::Statement * CQuery::statement(const std::string & key, const std::string & definition)
+{
+  const Statement * pStatement = NULL;
+
+#pragma omp critical (query_statement)
   {
-    pqxx::read_transaction * pWork = CConnection::work< pqxx::read_transaction >();
+    std::map< std::string, Statement >::iterator found = Statements.find(key);
 
-    if (pWork != NULL)
+    if (found != Statements.end())
+      pStatement = &found->second;
+    else if (!definition.empty())
       {
-        try
-          {
-            Result = pWork->exec(sql);
-            pWork->commit();
-          }
+        std::ostringstream Name;
+        Name << "epihiper_" << Statements.size();
+        pStatement = &Statements.insert(std::make_pair(key, Statement(Name.str(), definition))).first->second;
+      }
+  }
 
-        catch (const std::exception & e)
-          {
-            CLogger::error("CQuery::where: {}", CLogger::sanitize(e.what()));
-          }
+  return pStatement;
+}
+
+// static 
+void CQuery::copy(pqxx::transaction_base & work, const std::string & table, const CValueList & values)
+{
+  pqxx::stream_to Stream(work, table);
 
-        delete pWork;
+  CValueList::const_iterator it = values.begin();
+  CValueList::const_iterator end = values.end();
 
-        CLogger::debug("CQuery::{}: {} returned '{}' rows.", "sql", sql, Result.size());
+  for (; it != end; ++it)
+    switch (values.getType())
+      {
+      case CFieldValueList::Type::id:
+        Stream << std::make_tuple(it->toId());
+        break;
+
+      case CFieldValueList::Type::string:
+        Stream << std::make_tuple(it->toString());
+        break;
+
+      case CFieldValueList::Type::number:
+        Stream << std::make_tuple(it->toNumber());
+        break;
+
+      case CFieldValueList::Type::integer:
+        Stream << std::make_tuple(it->toInteger());
+        break;
+
+      case CFieldValueList::Type::boolean:
+      case CFieldValueList::Type::traitData:
+      case CFieldValueList::Type::traitValue:
+      case CFieldValueList::Type::__SIZE:
+        break;
       }
-  }
 
-  return Result;
+  Stream.complete();
 }
 
 // static 
@@ -564,7 +790,46 @@ std::string CQuery::createTemporaryTable(const std::string field, std::ostringst
   std::string TmpTableName = Table.getId() + '_' + Field.getId();
 
   query << "CREATE TEMPORARY TABLE IF NOT EXISTS " << CConnection::quote(TmpTableName) << " (";
-  query << CConnection::quote(Field.getId()) << " " << CConnection::quote(Field.getDBType()) << "); ";
+  query << CConnection::quote(Field.getId()) << " " << CConnection::quote(Field.getDBType()) << ") ON COMMIT DROP; ";
 
   return TmpTableName;
 }
+
+// static
+bool CQuery::lookup(const std::string & query, const std::string & values, CFieldValueList & result)
+{
+  bool Found = false;
+
+#pragma omp critical (query_cache)
+  {
+    Cache::const_iterator found = Results.find(query);
+
+    if (found != Results.end()
+        && found->second.first == values)
+      {
+        result.insert(found->second.second.begin(), found->second.second.end());
+        Found = true;
+      }
+  }
+
+  if (Found)
+    CLogger::debug("CQuery::lookup: {} {} returned '{}' cached rows.", query, values, result.size());
+
+  return Found;
+}
+
+// static
+bool CQuery::store(const std::string & query, const std::string & values, const CFieldValueList & result, const bool & success)
+{
+  if (!success)
+    return false;
+
+#pragma omp critical (query_cache)
+  {
+    // A changed constraint value replaces the previous result
+    Results.erase(query);
+    Results.insert(std::make_pair(query, std::make_pair(values, result)));
+  }
+
+  return true;
+}
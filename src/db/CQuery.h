@@ -32,6 +32,7 @@
 #ifndef SRC_DB_CQUERY_H_
 #define SRC_DB_CQUERY_H_
 
+#include <map>
 #include <string>
 #include <sstream>
 #include <pqxx/pqxx>
@@ -41,6 +42,7 @@
 class CValueInterface;
 class CValueList;
 class CFieldValueList;
+class CField;
 
 struct CQuery
 {
@@ -78,11 +80,65 @@ public:
 private:
   static std::string createTemporaryTable(const std::string field, std::ostringstream & query);
 
+  static pqxx::result exec(const std::string & sql);
+
+  static bool execute(const std::string & context,
+                      const std::string & prepare,
+                      const std::string & query,
+                      const CField & field,
+                      CFieldValueList & result,
+                      const std::string & copyTable = "",
+                      const CValueList * pCopy = NULL);
+
+  static bool fetch(const std::string & context,
+                    const std::string & prepare,
+                    const std::string & query,
+                    const CField & field,
+                    CFieldValueList & result,
+                    const std::string & copyTable,
+                    const CValueList * pCopy);
+
+  // A prepared statement's name and definition
+  typedef std::pair< std::string, std::string > Statement;
+
+  static bool execute(const std::string & context,
+                      const Statement & statement,
+                      const std::string & value,
+                      const CField & field,
+                      CFieldValueList & result);
+
+  static bool fetch(const std::string & context,
+                    const Statement & statement,
+                    const std::string & value,
+                    const CField & field,
+                    CFieldValueList & result);
+
+  // Retrieve the statement for the query shape, which is created if a definition is provided
+  static const Statement * statement(const std::string & key, const std::string & definition = "");
+
+  static std::map< std::string, Statement > Statements;
+
+  // Streams the values into the single column table through COPY
+  static void copy(pqxx::transaction_base & work, const std::string & table, const CValueList & values);
+
+  // Constraint lists larger than the threshold are copied instead of inserted as literals
+  static const size_t CopyThreshold;
+
+  // Constraint lists larger than the threshold are not cached
+  static const size_t CacheThreshold;
+
+  // The cache maps the query without its constraint values to the values and the result of the last evaluation
+  typedef std::map< std::string, std::pair< std::string, CFieldValueList > > Cache;
+
+  static bool lookup(const std::string & query, const std::string & values, CFieldValueList & result);
+  static bool store(const std::string & query, const std::string & values, const CFieldValueList & result, const bool & success);
+
+  static Cache Results;
+
   static std::string GlobalConstraint;
   static CContext< std::string > LocalConstraint;
   static size_t Limit;
   static void init();
-  static std::string limit(size_t & offset);
 };
 
 #endif /* SRC_DB_CQUERY_H_ */
@@ -22,6 +22,8 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <jansson.h>
 
@@ -31,6 +33,7 @@
 #include "diseaseModel/CHealthState.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CLogger.h"
+#include "utilities/CRandom.h"
 #include "utilities/CSimConfig.h"
 #include "utilities/CDirEntry.h"
 
@@ -80,19 +83,7 @@ const std::string & CAnalyzer::StatusFile()
 // virtual
 CAnalyzer::~CAnalyzer()
 {
-  if (mData != NULL)
-    {
-      StateStatistics * pIt = mData;
-      StateStatistics * pEnd = pIt + mpModel->getStateCount();
-
-      for (; pIt != pEnd; ++pIt)
-        {
-          delete [] pIt->histogramIn;
-          delete [] pIt->histogramOut;
-        }
-
-      delete[] mData;
-    }
+  deleteData(mData);
 
   if (mpModel != NULL)
     delete mpModel;
@@ -102,9 +93,12 @@ CAnalyzer::CAnalyzer(const std::string & jsonFile)
   : mSeed(std::numeric_limits< size_t >::max())
   , mMaxTick(100)
   , mSampleSize(100000)
+  , mMode(Mode::sampling)
   , mData(NULL)
+  , mTransitions()
   , mpModel(NULL)
   , mOutput("self://./output.csv")
+  , mAbsorption("self://./absorption.csv")
   , mStatus("self://./analyzer.status.json")
   , mLogLevel(CLogger::LogLevel::warn)
 {
@@ -134,6 +128,18 @@ CAnalyzer::CAnalyzer(const std::string & jsonFile)
         "description": "Path + name of the output file",
         "$ref": "./typeRegistry.json#/definitions/localPath"
       },
+      "absorption": {
+        "description": "Path + name of the file containing the mean and standard deviation of the time to absorption for each state (exact mode only)",
+        "$ref": "./typeRegistry.json#/definitions/localPath"
+      },
+      "mode": {
+        "description": "Estimate the statistics by sampling or compute the expected values exactly (default: sampling)",
+        "type": "string",
+        "enum": [
+          "sampling",
+          "exact"
+        ]
+      },
       "status": {
         "description": "Path + name of the output SciDuct status file",
         "allOf": [
@@ -201,6 +207,29 @@ CAnalyzer::CAnalyzer(const std::string & jsonFile)
   if (!CDirEntry::exist(CDirEntry::dirName(mOutput)))
     CDirEntry::createDir(CDirEntry::dirName(mOutput));
 
+  pValue = json_object_get(pRoot, "mode");
+
+  if (json_is_string(pValue))
+    {
+      if (strcmp(json_string_value(pValue), "exact") == 0)
+        mMode = Mode::exact;
+      else if (strcmp(json_string_value(pValue), "sampling") == 0)
+        mMode = Mode::sampling;
+      else
+        CLogger::error("CAnalyzer: Invalid mode '{}'.", json_string_value(pValue));
+    }
+
+  pValue = json_object_get(pRoot, "absorption");
+
+  if (json_is_string(pValue))
+    mAbsorption = json_string_value(pValue);
+
+  mAbsorption = CDirEntry::resolve(mAbsorption, jsonFile, DefaultDir);
+
+  if (mMode == Mode::exact
+      && !CDirEntry::exist(CDirEntry::dirName(mAbsorption)))
+    CDirEntry::createDir(CDirEntry::dirName(mAbsorption));
+
   pValue = json_object_get(pRoot, "logLevel");
 
   if (json_is_string(pValue))
@@ -278,21 +307,76 @@ void CAnalyzer::loadModel()
 
   if (!CLogger::hasErrors())
     {
-      mData = new StateStatistics[mpModel->getStateCount()];
-      StateStatistics * pIt = mData;
-      StateStatistics * pEnd = pIt + mpModel->getStateCount();
+      mData = createData();
+
+      // The progressions of each state with their probabilities and dwell time distributions
+      mTransitions.resize(mpModel->getStateCount());
 
-      for (CModel::state_t s = 0; pIt != pEnd; ++pIt, ++s)
+      for (const CHealthState & State : mpModel->getStates())
         {
-          pIt->healthState = s;
-          pIt->histogramIn = new size_t[mMaxTick + 1];
-          memset(pIt->histogramIn, 0, (mMaxTick + 1) * sizeof(size_t));
-          pIt->histogramOut = new size_t[mMaxTick + 1];
-          memset(pIt->histogramOut, 0, (mMaxTick + 1) * sizeof(size_t));
+          const CHealthState::PossibleProgressions & Progressions = State.getPossibleProgressions();
+
+          if (Progressions.A0 <= 0.0)
+            continue;
+
+          for (const CProgression * pProgression : Progressions.Progressions)
+            {
+              if (pProgression->getPropensity() <= 0.0)
+                continue;
+
+              Transition Transition;
+              Transition.exitState = pProgression->getExitState()->getIndex();
+              Transition.probability = pProgression->getPropensity() / Progressions.A0;
+              pProgression->dwellTimeProbabilities(Transition.dwellTime);
+              Transition.durationMean = 0.0;
+              Transition.durationSquares = 0.0;
+
+              for (size_t k = 0; k < Transition.dwellTime.size(); ++k)
+                {
+                  Transition.durationMean += k * Transition.dwellTime[k];
+                  Transition.durationSquares += k * k * Transition.dwellTime[k];
+                }
+
+              mTransitions[State.getIndex()].push_back(Transition);
+            }
         }
     }
 }
 
+CAnalyzer::StateStatistics * CAnalyzer::createData() const
+{
+  StateStatistics * pData = new StateStatistics[mpModel->getStateCount()];
+  StateStatistics * pIt = pData;
+  StateStatistics * pEnd = pIt + mpModel->getStateCount();
+
+  for (CModel::state_t s = 0; pIt != pEnd; ++pIt, ++s)
+    {
+      pIt->healthState = s;
+      pIt->histogramIn = new double[mMaxTick + 1];
+      std::fill(pIt->histogramIn, pIt->histogramIn + mMaxTick + 1, 0.0);
+      pIt->histogramOut = new double[mMaxTick + 1];
+      std::fill(pIt->histogramOut, pIt->histogramOut + mMaxTick + 1, 0.0);
+    }
+
+  return pData;
+}
+
+void CAnalyzer::deleteData(StateStatistics * pData) const
+{
+  if (pData == NULL)
+    return;
+
+  StateStatistics * pIt = pData;
+  StateStatistics * pEnd = pIt + mpModel->getStateCount();
+
+  for (; pIt != pEnd; ++pIt)
+    {
+      delete [] pIt->histogramIn;
+      delete [] pIt->histogramOut;
+    }
+
+  delete [] pData;
+}
 
 void CAnalyzer::run()
 {
@@ -306,60 +390,12 @@ void CAnalyzer::run()
       Exposed.insert(itTransmission->getExitState());
     }
 
-  // For each  exit state sample transmission  sampleSize times up to maxTick
-  std::set< const CHealthState * >::const_iterator itExposed = Exposed.begin();
-  std::set< const CHealthState * >::const_iterator endExposed = Exposed.end();
-
   size_t MaxTick = 0;
 
-  for (; itExposed != endExposed; ++itExposed)
-    {
-      CModel::state_t ExposedType = (*itExposed)->getIndex();
-
-      for (size_t i = 0; i != mSampleSize; ++i)
-        {
-          const CHealthState * pState = *itExposed;
-          size_t Tick = 0;
-
-          while (pState != NULL && Tick <= mMaxTick)
-            {
-              // Record the current state and time
-              CModel::state_t StateType = pState->getIndex();
-             
-              StateStatistics & Statistics = mData[StateType];
-              Statistics.exposedState.insert(ExposedType);
-              ++Statistics.total;
-              ++Statistics.histogramIn[Tick];
-              
-              double delta = Tick - Statistics.entryTickMean;
-              Statistics.entryTickMean += delta/Statistics.total;
-              Statistics.entryTickSD += delta * (Tick - Statistics.entryTickMean);
-
-              // Advance the state according to the possible progressions.
-              const CProgression * pProgression = pState->nextProgression(nullptr);
-              if (pProgression != NULL)
-                {
-                  pState = pProgression->getExitState();
-                  unsigned int Duration = pProgression->dwellTime(nullptr);
-                  Tick += Duration;
-                  
-                  if (Tick <= mMaxTick)
-                    ++Statistics.histogramOut[Tick];
-
-                  delta = Duration - Statistics.durationMean;
-                  Statistics.durationMean += delta/Statistics.total;
-                  Statistics.durationSD += delta * (Duration - Statistics.durationMean);
-                }
-              else
-                {
-                  if (Tick > MaxTick)
-                    MaxTick = Tick;
-
-                  pState = NULL;
-                }
-            }
-        }
-    }
+  if (mMode == Mode::exact)
+    computeExact(std::vector< const CHealthState * >(Exposed.begin(), Exposed.end()), MaxTick);
+  else
+    sample(std::vector< const CHealthState * >(Exposed.begin(), Exposed.end()), MaxTick);
 
   // Write the result to a csv file
   std::ofstream os(mOutput);
@@ -372,26 +408,40 @@ void CAnalyzer::run()
 
   os << std::endl;
 
+  // The expected values of the exact mode are given per exposure
+  double Samples = (mMode == Mode::exact) ? 1.0 : mSampleSize;
+
   StateStatistics * pIt = mData;
   StateStatistics * pEnd = pIt + mpModel->getStateCount();
 
   for (; pIt != pEnd; ++pIt)
     {
-      os << mpModel->stateFromType(pIt->healthState)->getId() << "," << pIt->total << "," << ((double )pIt->total)/(pIt->exposedState.size() * mSampleSize) << "," << pIt->entryTickMean << "," << pIt->entryTickSD/pIt->total << "," << pIt->durationMean << "," << pIt->durationSD/pIt->total << ",in" ;
+      double EntryTickMean = pIt->total > 0.0 ? pIt->entryTick / pIt->total : 0.0;
+      double DurationMean = pIt->total > 0.0 ? pIt->duration / pIt->total : 0.0;
+
+      os << mpModel->stateFromType(pIt->healthState)->getId() << ",";
+      writeValue(os, pIt->total);
+      os << "," << pIt->total / (pIt->exposedState.size() * Samples)
+         << "," << EntryTickMean << "," << pIt->entryTickSquares / pIt->total - EntryTickMean * EntryTickMean
+         << "," << DurationMean << "," << pIt->durationSquares / pIt->total - DurationMean * DurationMean << ",in" ;
 
       for (size_t i = 0; i <= MaxTick; ++i)
-        os << "," << pIt->histogramIn[i];
+        {
+          os << ",";
+          writeValue(os, pIt->histogramIn[i]);
+        }
 
       os << std::endl;
 
       os <<  ",,,,,,,current" ;
 
-      size_t Current = 0;
+      double Current = 0;
 
       for (size_t i = 0; i <= MaxTick; ++i)
         {
           Current += pIt->histogramIn[i] - pIt->histogramOut[i];
-          os << "," << Current;
+          os << ",";
+          writeValue(os, Current);
         }
 
       os << std::endl;
@@ -399,9 +449,380 @@ void CAnalyzer::run()
       os <<  ",,,,,,,out" ;
 
       for (size_t i = 0; i <= MaxTick; ++i)
-        os << "," << pIt->histogramOut[i];
+        {
+          os << ",";
+          writeValue(os, pIt->histogramOut[i]);
+        }
 
       os << std::endl;
 
     }
+
+  if (mMode == Mode::exact)
+    writeAbsorption();
+}
+
+void CAnalyzer::sample(const std::vector< const CHealthState * > & exposed, size_t & maxTick)
+{
+  // Each sample draws from its own counter based stream and all statistics are sums of integers. The result
+  // therefore does neither depend on the number of threads nor on the scheduling.
+  CRandom::CounterBased = true;
+
+  std::vector< StateStatistics * > ThreadData(omp_get_max_threads());
+  std::vector< size_t > ThreadMaxTick(omp_get_max_threads(), 0);
+
+  for (StateStatistics *& pData : ThreadData)
+    pData = createData();
+
+#pragma omp parallel
+  {
+    StateStatistics * pData = ThreadData[omp_get_thread_num()];
+    size_t & MaxTick = ThreadMaxTick[omp_get_thread_num()];
+
+    // For each exit state sample transmission sampleSize times up to maxTick
+    for (size_t Exposed = 0; Exposed < exposed.size(); ++Exposed)
+      {
+        CModel::state_t ExposedType = exposed[Exposed]->getIndex();
+
+#pragma omp for schedule(dynamic, 1024)
+        for (size_t i = 0; i < mSampleSize; ++i)
+          {
+            CRandom::G.Active().setStream(i, CRandom::Stream::sampling, Exposed);
+
+            const CHealthState * pState = exposed[Exposed];
+            size_t Tick = 0;
+
+            while (pState != NULL && Tick <= mMaxTick)
+              {
+                // Record the current state and time
+                StateStatistics & Statistics = pData[pState->getIndex()];
+                Statistics.exposedState.insert(ExposedType);
+                Statistics.total += 1.0;
+                Statistics.histogramIn[Tick] += 1.0;
+                Statistics.entryTick += Tick;
+                Statistics.entryTickSquares += (double) Tick * Tick;
+
+                // Advance the state according to the possible progressions.
+                const CProgression * pProgression = pState->nextProgression(nullptr);
+
+                if (pProgression != NULL)
+                  {
+                    pState = pProgression->getExitState();
+                    unsigned int Duration = pProgression->dwellTime(nullptr);
+                    Tick += Duration;
+
+                    if (Tick <= mMaxTick)
+                      Statistics.histogramOut[Tick] += 1.0;
+
+                    Statistics.duration += Duration;
+                    Statistics.durationSquares += (double) Duration * Duration;
+                  }
+                else
+                  {
+                    if (Tick > MaxTick)
+                      MaxTick = Tick;
+
+                    pState = NULL;
+                  }
+              }
+          }
+      }
+  }
+
+  for (size_t t = 0; t < ThreadData.size(); ++t)
+    {
+      StateStatistics * pIt = mData;
+      StateStatistics * pEnd = pIt + mpModel->getStateCount();
+      const StateStatistics * pThread = ThreadData[t];
+
+      for (; pIt != pEnd; ++pIt, ++pThread)
+        {
+          pIt->total += pThread->total;
+          pIt->entryTick += pThread->entryTick;
+          pIt->entryTickSquares += pThread->entryTickSquares;
+          pIt->duration += pThread->duration;
+          pIt->durationSquares += pThread->durationSquares;
+          pIt->exposedState.insert(pThread->exposedState.begin(), pThread->exposedState.end());
+
+          for (size_t i = 0; i <= mMaxTick; ++i)
+            {
+              pIt->histogramIn[i] += pThread->histogramIn[i];
+              pIt->histogramOut[i] += pThread->histogramOut[i];
+            }
+        }
+
+      maxTick = std::max(maxTick, ThreadMaxTick[t]);
+      deleteData(ThreadData[t]);
+    }
+}
+
+void CAnalyzer::computeExact(const std::vector< const CHealthState * > & exposed, size_t & maxTick)
+{
+  // Progressions without delay with a smaller probability are ignored, which terminates cycles without delay.
+  static const double Epsilon = 1e-15;
+
+  size_t StateCount = mpModel->getStateCount();
+
+  // Entries[s * (mMaxTick + 1) + t] is the probability to enter state s at tick t after a delay.
+  std::vector< double > Entries(StateCount * (mMaxTick + 1));
+  std::vector< double > Pending(StateCount);
+
+  for (const CHealthState * pExposed : exposed)
+    {
+      std::fill(Entries.begin(), Entries.end(), 0.0);
+      Entries[pExposed->getIndex() * (mMaxTick + 1)] = 1.0;
+
+      for (size_t Tick = 0; Tick <= mMaxTick; ++Tick)
+        {
+          for (size_t s = 0; s < StateCount; ++s)
+            Pending[s] = Entries[s * (mMaxTick + 1) + Tick];
+
+          // Progressions without delay enter the exit state at the same tick.
+          bool Propagate = true;
+
+          while (Propagate)
+            {
+              Propagate = false;
+
+              for (size_t s = 0; s < StateCount; ++s)
+                {
+                  double Probability = Pending[s];
+
+                  if (Probability <= 0.0)
+                    continue;
+
+                  Pending[s] = 0.0;
+
+                  StateStatistics & Statistics = mData[s];
+                  Statistics.exposedState.insert(pExposed->getIndex());
+                  Statistics.total += Probability;
+                  Statistics.histogramIn[Tick] += Probability;
+                  Statistics.entryTick += Probability * Tick;
+                  Statistics.entryTickSquares += Probability * Tick * Tick;
+
+                  if (mTransitions[s].empty())
+                    {
+                      if (Tick > maxTick)
+                        maxTick = Tick;
+
+                      continue;
+                    }
+
+                  for (const Transition & Transition : mTransitions[s])
+                    {
+                      double Weight = Probability * Transition.probability;
+
+                      Statistics.duration += Weight * Transition.durationMean;
+                      Statistics.durationSquares += Weight * Transition.durationSquares;
+
+                      for (size_t k = 0; k < Transition.dwellTime.size() && Tick + k <= mMaxTick; ++k)
+                        {
+                          double Exit = Weight * Transition.dwellTime[k];
+
+                          if (Exit == 0.0)
+                            continue;
+
+                          Statistics.histogramOut[Tick + k] += Exit;
+
+                          if (k == 0)
+                            {
+                              if (Exit > Epsilon)
+                                {
+                                  Pending[Transition.exitState] += Exit;
+                                  Propagate = true;
+                                }
+                            }
+                          else
+                            Entries[Transition.exitState * (mMaxTick + 1) + Tick + k] += Exit;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CAnalyzer::computeAbsorption(std::vector< double > & mean, std::vector< double > & sd) const
+{
+  size_t StateCount = mpModel->getStateCount();
+
+  mean.assign(StateCount, std::numeric_limits< double >::infinity());
+  sd.assign(StateCount, std::numeric_limits< double >::infinity());
+
+  // Determine the states from which an absorbing state can be reached.
+  std::vector< bool > Absorbable(StateCount, false);
+  bool Changed = true;
+
+  while (Changed)
+    {
+      Changed = false;
+
+      for (size_t s = 0; s < StateCount; ++s)
+        if (!Absorbable[s])
+          {
+            bool Reaches = mTransitions[s].empty();
+
+            for (const Transition & Transition : mTransitions[s])
+              Reaches |= Absorbable[Transition.exitState];
+
+            if (Reaches)
+              {
+                Absorbable[s] = true;
+                Changed = true;
+              }
+          }
+    }
+
+  // The time to absorption is finite only if all reachable states are absorbable.
+  std::vector< size_t > Index(StateCount, StateCount);
+  size_t Size = 0;
+
+  for (size_t s = 0; s < StateCount; ++s)
+    {
+      std::vector< bool > Reachable(StateCount, false);
+      std::vector< size_t > Stack(1, s);
+      Reachable[s] = true;
+      bool Finite = true;
+
+      while (!Stack.empty() && Finite)
+        {
+          size_t Current = Stack.back();
+          Stack.pop_back();
+          Finite = Absorbable[Current];
+
+          for (const Transition & Transition : mTransitions[Current])
+            if (!Reachable[Transition.exitState])
+              {
+                Reachable[Transition.exitState] = true;
+                Stack.push_back(Transition.exitState);
+              }
+        }
+
+      if (!Finite)
+        continue;
+
+      if (mTransitions[s].empty())
+        {
+          mean[s] = 0.0;
+          sd[s] = 0.0;
+        }
+      else
+        Index[s] = Size++;
+    }
+
+  // The first and second moments of the time to absorption T of the transient states satisfy
+  //   E[T_s] - sum_p P(p) E[T_exit(p)] = sum_p P(p) E[D_p]
+  //   E[T_s^2] - sum_p P(p) E[T_exit(p)^2] = sum_p P(p) (E[D_p^2] + 2 E[D_p] E[T_exit(p)])
+  std::vector< double > Matrix(Size * Size, 0.0);
+  std::vector< double > First(Size, 0.0);
+  std::vector< double > Second(Size, 0.0);
+
+  for (size_t s = 0; s < StateCount; ++s)
+    if (Index[s] < Size)
+      {
+        Matrix[Index[s] * Size + Index[s]] += 1.0;
+
+        for (const Transition & Transition : mTransitions[s])
+          {
+            if (Index[Transition.exitState] < Size)
+              Matrix[Index[s] * Size + Index[Transition.exitState]] -= Transition.probability;
+
+            First[Index[s]] += Transition.probability * Transition.durationMean;
+          }
+      }
+
+  // LU decomposition with partial pivoting, which is used for both moments.
+  std::vector< size_t > Pivot(Size);
+
+  for (size_t k = 0; k < Size; ++k)
+    {
+      size_t Row = k;
+
+      for (size_t i = k + 1; i < Size; ++i)
+        if (fabs(Matrix[i * Size + k]) > fabs(Matrix[Row * Size + k]))
+          Row = i;
+
+      Pivot[k] = Row;
+
+      if (Row != k)
+        for (size_t j = 0; j < Size; ++j)
+          std::swap(Matrix[k * Size + j], Matrix[Row * Size + j]);
+
+      for (size_t i = k + 1; i < Size; ++i)
+        {
+          Matrix[i * Size + k] /= Matrix[k * Size + k];
+
+          for (size_t j = k + 1; j < Size; ++j)
+            Matrix[i * Size + j] -= Matrix[i * Size + k] * Matrix[k * Size + j];
+        }
+    }
+
+  std::vector< double > * Moments[2] = {&First, &Second};
+
+  for (size_t m = 0; m < 2; ++m)
+    {
+      std::vector< double > & Solution = *Moments[m];
+
+      if (m == 1)
+        for (size_t s = 0; s < StateCount; ++s)
+          if (Index[s] < Size)
+            for (const Transition & Transition : mTransitions[s])
+              Second[Index[s]] += Transition.probability
+                                  * (Transition.durationSquares
+                                     + 2.0 * Transition.durationMean * (Index[Transition.exitState] < Size ? First[Index[Transition.exitState]] : 0.0));
+
+      for (size_t k = 0; k < Size; ++k)
+        std::swap(Solution[k], Solution[Pivot[k]]);
+
+      for (size_t i = 1; i < Size; ++i)
+        for (size_t j = 0; j < i; ++j)
+          Solution[i] -= Matrix[i * Size + j] * Solution[j];
+
+      for (size_t i = Size; i-- > 0;)
+        {
+          for (size_t j = i + 1; j < Size; ++j)
+            Solution[i] -= Matrix[i * Size + j] * Solution[j];
+
+          Solution[i] /= Matrix[i * Size + i];
+        }
+    }
+
+  for (size_t s = 0; s < StateCount; ++s)
+    if (Index[s] < Size)
+      {
+        mean[s] = First[Index[s]];
+        sd[s] = sqrt(std::max(0.0, Second[Index[s]] - First[Index[s]] * First[Index[s]]));
+      }
+}
+
+bool CAnalyzer::writeAbsorption() const
+{
+  std::vector< double > Mean;
+  std::vector< double > SD;
+
+  computeAbsorption(Mean, SD);
+
+  std::ofstream os(mAbsorption);
+
+  if (os.fail())
+    {
+      CLogger::error("CAnalyzer: Failed to open '{}'.", mAbsorption);
+      return false;
+    }
+
+  os << "State,Absorption Tick Mean,Absorption Tick SD" << std::endl;
+
+  for (size_t s = 0; s < mpModel->getStateCount(); ++s)
+    os << mpModel->stateFromType(s)->getId() << "," << Mean[s] << "," << SD[s] << std::endl;
+
+  return true;
+}
+
+void CAnalyzer::writeValue(std::ostream & os, const double & value) const
+{
+  // Sampled counts are integers
+  if (mMode == Mode::sampling)
+    os << (size_t) value;
+  else
+    os << value;
 }
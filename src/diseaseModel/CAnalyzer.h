@@ -26,25 +26,38 @@
 #define SRC_DISEASEMODEL_CANALYZER_H_
 
 #include <string>
+#include <vector>
 
 #include "diseaseModel/CModel.h"
 #include "utilities/CLogger.h"
 
 struct json_t;
 
+class CHealthState;
+
 class CAnalyzer
 {
 public:
+  enum struct Mode
+  {
+    sampling,
+    exact
+  };
+
+  /**
+   * The statistics are sums over all entries into the state. When sampling each entry has the weight 1
+   * and in the exact mode the weight is its probability.
+   */
   struct StateStatistics
   {
     CModel::state_t healthState = 0;
-    size_t total = 0;
-    size_t * histogramIn = NULL;
-    size_t * histogramOut = NULL;
-    double entryTickMean = 0;
-    double entryTickSD = 0;
-    double durationMean = 0;
-    double durationSD = 0;
+    double total = 0;
+    double * histogramIn = NULL;
+    double * histogramOut = NULL;
+    double entryTick = 0;
+    double entryTickSquares = 0;
+    double duration = 0;
+    double durationSquares = 0;
     std::set< CModel::state_t > exposedState = std::set< CModel::state_t >();
   };
 
@@ -73,14 +86,41 @@ private:
 
   void run();
 
+  // A progression of a state with its probability and dwell time distribution
+  struct Transition
+  {
+    CModel::state_t exitState;
+    double probability;
+    std::vector< double > dwellTime;
+    double durationMean;
+    double durationSquares;
+  };
+
+  StateStatistics * createData() const;
+
+  void deleteData(StateStatistics * pData) const;
+
+  void sample(const std::vector< const CHealthState * > & exposed, size_t & maxTick);
+
+  void computeExact(const std::vector< const CHealthState * > & exposed, size_t & maxTick);
+
+  void computeAbsorption(std::vector< double > & mean, std::vector< double > & sd) const;
+
+  bool writeAbsorption() const;
+
+  void writeValue(std::ostream & os, const double & value) const;
+
   static CAnalyzer * INSTANCE;
 
   size_t mSeed;
   size_t mMaxTick;
   size_t mSampleSize;
+  Mode mMode;
   StateStatistics * mData;
+  std::vector< std::vector< Transition > > mTransitions;
   CModel * mpModel;
   std::string mOutput;
+  std::string mAbsorption;
   std::string mStatus;
   std::string mModel;
   CLogger::LogLevel mLogLevel;
@@ -22,6 +22,7 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <cmath>
 #include <jansson.h>
 
 #include "diseaseModel/CDistribution.h"
@@ -31,6 +32,7 @@
 CDistribution::CDistribution()
   : mType(Type::__NONE)
   , mDiscrete()
+  , mDiscreteTable()
   , mUniformSet()
   , mpSample(NULL)
   , mFixed(0.0)
@@ -45,6 +47,7 @@ CDistribution::CDistribution()
 CDistribution::CDistribution(const CDistribution & src)
   : mType(src.mType)
   , mDiscrete(src.mDiscrete)
+  , mDiscreteTable(src.mDiscreteTable)
   , mUniformSet(src.mUniformSet)
   , mpSample(src.mpSample)
   , mFixed(0.0)
@@ -253,6 +256,13 @@ void CDistribution::fromJSON(const json_t * json)
           return;
         }
 
+      std::vector< double > Probabilities;
+
+      for (const std::pair< double, unsigned int > & item : mDiscrete)
+        Probabilities.push_back(item.first);
+
+      mDiscreteTable.init(Probabilities);
+
       mValid = true;
       mUniformReal.init(0, std::nextafter(Total, 2.0));
     }
@@ -458,20 +468,7 @@ unsigned int CDistribution::fixed() const
 
 unsigned int CDistribution::discrete() const
 {
-  double A = mUniformReal.sample();
-
-  std::vector< std::pair< double, unsigned int > >::const_iterator it = mDiscrete.begin();
-  std::vector< std::pair< double, unsigned int > >::const_iterator end = mDiscrete.end();
-
-  for (; it != end; ++it)
-    {
-      A -= it->first;
-
-      if (A < 0.0)
-        return it->second;
-    }
-
-  return mDiscrete.rbegin()->second;
+  return mDiscrete[mDiscreteTable.index(mUniformReal.sample())].second;
 }
 
 unsigned int CDistribution::uniformSet() const
@@ -494,6 +491,173 @@ unsigned int CDistribution::gamma() const
   return std::round(std::max(0.0, mGamma.sample()));
 }
 
+// The regularized lower incomplete gamma function P(a, x), i.e., the cumulative distribution of Gamma(a, 1)
+static double regularizedGamma(const double & a, const double & x)
+{
+  static const double Epsilon = 1e-15;
+  static const double Tiny = 1e-300;
+
+  if (x <= 0.0)
+    return 0.0;
+
+  if (a <= 0.0)
+    return 1.0;
+
+  double Prefactor = exp(-x + a * log(x) - lgamma(a));
+
+  if (x < a + 1.0)
+    {
+      // Series expansion
+      double Term = 1.0 / a;
+      double Sum = Term;
+
+      for (double n = a + 1.0; n < a + 10000.0; n += 1.0)
+        {
+          Term *= x / n;
+          Sum += Term;
+
+          if (fabs(Term) < fabs(Sum) * Epsilon)
+            break;
+        }
+
+      return Sum * Prefactor;
+    }
+
+  // Continued fraction for the upper incomplete gamma function (modified Lentz's method)
+  double b = x + 1.0 - a;
+  double c = 1.0 / Tiny;
+  double d = 1.0 / b;
+  double h = d;
+
+  for (double i = 1.0; i < 10000.0; i += 1.0)
+    {
+      double an = -i * (i - a);
+      b += 2.0;
+      d = an * d + b;
+
+      if (fabs(d) < Tiny)
+        d = Tiny;
+
+      c = b + an / c;
+
+      if (fabs(c) < Tiny)
+        c = Tiny;
+
+      d = 1.0 / d;
+      double Delta = d * c;
+      h *= Delta;
+
+      if (fabs(Delta - 1.0) < Epsilon)
+        break;
+    }
+
+  return 1.0 - Prefactor * h;
+}
+
+void CDistribution::probabilities(std::vector< double > & probabilities) const
+{
+  // The probability which may be ignored in the tail of unbounded distributions
+  static const double Tail = 1e-12;
+  static const size_t MaxValue = 1 << 24;
+
+  probabilities.clear();
+
+  double Mean = 0.0;
+  double Scale = 0.0;
+  double Shape = 0.0;
+
+  switch (mType)
+    {
+    case Type::fixed:
+      probabilities.resize(mFixed + 1, 0.0);
+      probabilities[mFixed] = 1.0;
+      return;
+      break;
+
+    case Type::discrete:
+      for (const std::pair< double, unsigned int > & item : mDiscrete)
+        {
+          if (probabilities.size() <= item.second)
+            probabilities.resize(item.second + 1, 0.0);
+
+          probabilities[item.second] += item.first / mDiscreteTable.total();
+        }
+      return;
+      break;
+
+    case Type::uniform:
+      if (mpSample == &CDistribution::uniformSet)
+        {
+          for (const unsigned int & Value : mUniformSet)
+            {
+              if (probabilities.size() <= Value)
+                probabilities.resize(Value + 1, 0.0);
+
+              probabilities[Value] += 1.0 / mUniformSet.size();
+            }
+        }
+      else
+        {
+          const CRandom::uniform_int & Uniform = mUniformInt.Master().distribution;
+          probabilities.resize(Uniform.b() + 1, 0.0);
+
+          for (size_t k = Uniform.a(); k <= Uniform.b(); ++k)
+            probabilities[k] = 1.0 / (Uniform.b() - Uniform.a() + 1);
+        }
+      return;
+      break;
+
+    case Type::normal:
+      Mean = mNormal.Master().distribution.mean();
+      Scale = mNormal.Master().distribution.stddev();
+
+      if (Scale <= 0.0)
+        {
+          size_t Value = std::round(std::max(0.0, Mean));
+          probabilities.resize(Value + 1, 0.0);
+          probabilities[Value] = 1.0;
+          return;
+        }
+      break;
+
+    case Type::gamma:
+      Shape = mGamma.Master().distribution.alpha();
+      Scale = mGamma.Master().distribution.beta();
+      Mean = Shape * Scale;
+
+      if (Shape <= 0.0 || Scale <= 0.0)
+        {
+          probabilities.push_back(1.0);
+          return;
+        }
+      break;
+
+    case Type::__NONE:
+      return;
+      break;
+    }
+
+  // The sampled value is round(max(0, x)), i.e., k is sampled for x in [k - 0.5, k + 0.5) and 0 for all x < 0.5.
+  double Lower = 0.0;
+
+  for (size_t k = 0; k < MaxValue; ++k)
+    {
+      double Upper;
+
+      if (mType == Type::normal)
+        Upper = 0.5 * erfc((Mean - k - 0.5) / (Scale * M_SQRT2));
+      else
+        Upper = regularizedGamma(Shape, (k + 0.5) / Scale);
+
+      probabilities.push_back(std::max(0.0, Upper - Lower));
+      Lower = Upper;
+
+      if (1.0 - Upper < Tail
+          && k + 0.5 > Mean)
+        break;
+    }
+}
+
 void CDistribution::normalizeJSON()
 {
   if (mType == Type::__NONE)
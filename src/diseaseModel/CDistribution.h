@@ -30,6 +30,7 @@
 #include <utility>
 
 #include "utilities/CRandom.h"
+#include "utilities/CGuideTable.h"
 
 struct json_t;
 
@@ -58,6 +59,13 @@ public:
 
   unsigned int sample() const;
 
+  /**
+   * Determine the probabilities of the sampled values, i.e., probabilities[k] is the probability that k is sampled.
+   * The unbounded normal and gamma distributions are truncated when the remaining probability is negligible.
+   * @param std::vector< double > & probabilities
+   */
+  void probabilities(std::vector< double > & probabilities) const;
+
   std::string & getJson();
 
   bool setJson(const std::string & json);
@@ -67,6 +75,7 @@ private:
 
   Type mType;
   std::vector< std::pair <double, unsigned int > > mDiscrete;
+  CGuideTable mDiscreteTable;
   std::vector< unsigned int > mUniformSet;
   unsigned int (CDistribution::*mpSample)() const;
 
@@ -26,36 +26,40 @@
 
 #include "diseaseModel/CHealthState.h"
 #include "diseaseModel/CProgression.h"
+#include "network/CNode.h"
 #include "utilities/CLogger.h"
 #include "utilities/CMetadata.h"
 
 // static
-const CProgression * CHealthState::defaultMethod(const CHealthState * pHealthState, const CNode * /* pNode */)
+const CProgression * CHealthState::defaultMethod(const CHealthState * pHealthState, const CNode * pNode)
 {
   const PossibleProgressions & Progressions = pHealthState->getPossibleProgressions();
 
   if (Progressions.A0 > 0.0
       && !Progressions.Progressions.empty())
     {
-      double alpha = CRandom::uniform_real(0.0, Progressions.A0)(CRandom::G.Active());
-
-      for (const CProgression * pProgression : Progressions.Progressions)
-        {
-          alpha -= pProgression->getPropensity();
+      if (pNode != NULL)
+        CRandom::G.Active().setStream(pNode->id, CRandom::Stream::progression, pHealthState->getIndex());
 
-          if (alpha < 0.0)
-            return pProgression;
-        }
+      double alpha = CRandom::uniform_real(0.0, Progressions.A0)(CRandom::G.Active());
 
-      return Progressions.Progressions.back();
+      return Progressions.Progressions[Progressions.Table.index(alpha)];
     }
 
   return NULL;
 }
 
+// static
+void CHealthState::defaultBatchMethod(const CHealthState * pHealthState, const CNode * const * pNodes, size_t size, const CProgression ** pProgressions)
+{
+  for (size_t i = 0; i < size; ++i)
+    pProgressions[i] = pHealthState->ProgressionMethod::mpCustomMethod(pHealthState, pNodes[i]);
+}
+
 CHealthState::CHealthState()
   : CAnnotation()
-  , CCustomMethod(&CHealthState::defaultMethod)
+  , ProgressionMethod(&CHealthState::defaultMethod)
+  , BatchMethod(&CHealthState::defaultBatchMethod)
   , mId()
   , mIndex(std::numeric_limits< size_t >::max())
   , mSusceptibility(-1.0)
@@ -85,7 +89,8 @@ CHealthState::CHealthState()
 
 CHealthState::CHealthState(const CHealthState & src)
   : CAnnotation(src)
-  , CCustomMethod(src)
+  , ProgressionMethod(src)
+  , BatchMethod(src)
   , mId(src.mId)
   , mIndex(src.mIndex)
   , mSusceptibility(src.mSusceptibility)
@@ -234,26 +239,47 @@ const CHealthState::PossibleProgressions & CHealthState::getPossibleProgressions
 
 void CHealthState::addProgression(const CProgression * pProgression)
 {
-  if (mProgressions.Progressions.size() == 0)
-    {
-      mProgressions.A0 = 0.0;
-    }
-
-  mProgressions.A0 += pProgression->getPropensity();
   mProgressions.Progressions.push_back(pProgression);
+  updatePossibleProgression();
 }
 
 void CHealthState::updatePossibleProgression()
 {
+  std::vector< double > Propensities;
+
   mProgressions.A0 = 0.0;
 
   for (const CProgression * pProgression : mProgressions.Progressions)
-    mProgressions.A0 += pProgression->getPropensity();
+    {
+      mProgressions.A0 += pProgression->getPropensity();
+      Propensities.push_back(pProgression->getPropensity());
+    }
+
+  mProgressions.Table.init(Propensities);
 }
 
 const CProgression * CHealthState::nextProgression(const CNode * pNode) const
 {
-  return mpCustomMethod(this, pNode);
+  // A custom batch method takes precedence over the per node method.
+  if (hasCustomBatchMethod())
+    {
+      const CProgression * pProgression = NULL;
+      BatchMethod::mpCustomMethod(this, &pNode, 1, &pProgression);
+
+      return pProgression;
+    }
+
+  return ProgressionMethod::mpCustomMethod(this, pNode);
+}
+
+void CHealthState::nextProgressions(const CNode * const * pNodes, size_t size, const CProgression ** pProgressions) const
+{
+  BatchMethod::mpCustomMethod(this, pNodes, size, pProgressions);
+}
+
+bool CHealthState::hasCustomBatchMethod() const
+{
+  return BatchMethod::mpCustomMethod != BatchMethod::mpDefaultMethod;
 }
 
 const CContext< CHealthState::Counts > & CHealthState::getLocalCounts() const
@@ -32,19 +32,30 @@
 #include "utilities/CContext.h"
 #include "plugins/CCustomMethod.h"
 #include "math/CValueInterface.h"
+#include "utilities/CGuideTable.h"
 
 class CProgression;
 class pNode;
 struct json_t;
 class CMetadata;
 
-class CHealthState: public CAnnotation, public CCustomMethod< CCustomMethodType::state_progression >
+class CHealthState: public CAnnotation,
+                    public CCustomMethod< CCustomMethodType::state_progression >,
+                    public CCustomMethod< CCustomMethodType::state_progressions >
 {
+  typedef CCustomMethod< CCustomMethodType::state_progression > ProgressionMethod;
+  typedef CCustomMethod< CCustomMethodType::state_progressions > BatchMethod;
+
 public:
+  using ProgressionMethod::setCustomMethod;
+  using BatchMethod::setCustomMethod;
+
   struct PossibleProgressions
   {
     double A0 = 0.0;
     std::vector< const CProgression * > Progressions;
+    // The table selecting a progression for a value in [0, A0]
+    CGuideTable Table;
   };
 
   struct Counts
@@ -56,6 +67,9 @@ public:
 
   static const CProgression * defaultMethod(const CHealthState * pHealthState, const CNode * pNode);
 
+  // The default batch method which calls the progression method for each node
+  static void defaultBatchMethod(const CHealthState * pHealthState, const CNode * const * pNodes, size_t size, const CProgression ** pProgressions);
+
   CHealthState();
 
   CHealthState(const CHealthState & src);
@@ -96,6 +110,10 @@ public:
 
   const CProgression * nextProgression(const CNode * pNode) const;
 
+  void nextProgressions(const CNode * const * pNodes, size_t size, const CProgression ** pProgressions) const;
+
+  bool hasCustomBatchMethod() const;
+
   const CContext< Counts > & getLocalCounts() const;
 
   CContext< Counts > & getLocalCounts();
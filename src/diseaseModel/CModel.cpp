@@ -22,6 +22,7 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <algorithm>
 #include <fstream>
 #include <jansson.h>
 
@@ -39,8 +40,12 @@
 #include "network/CNode.h"
 #include "utilities/CRandom.h"
 #include "utilities/CLogger.h"
+#include "utilities/CFormatBuffer.h"
 #include "variables/CVariableList.h"
 
+// The number of nodes in the chunks which are dynamically scheduled across the threads of a rank
+static const size_t ChunkSize = 1024;
+
 // static
 void CModel::Load(const std::string & modelFile)
 {
@@ -62,6 +67,7 @@ void CModel::clear()
 
 CModel::CModel(const std::string & modelFile)
   : CAnnotation()
+  , CCustomMethod(&CModel::defaultMethod)
   , mStates()
   , mStateCount(0)
   , mId2State()
@@ -71,7 +77,11 @@ CModel::CModel(const std::string & modelFile)
   , mPossibleTransmissions(NULL)
   , mpTransmissibility(NULL)
   , mValid(false)
+  , mSelected()
+  , mStateChanges()
 {
+  mSelected.init();
+  mStateChanges.init();
   CVariableList::INSTANCE.append(CVariable::transmissibility());
   mpTransmissibility = &CVariableList::INSTANCE["%transmissibility%"];
 
@@ -277,90 +287,190 @@ bool CModel::ProcessTransmissions()
   return INSTANCE->processTransmissions();
 }
 
+// static
+void CModel::SetCustomMethod(CCustomMethodType::transmission_propensities pCustomMethod)
+{
+  INSTANCE->setCustomMethod(pCustomMethod);
+}
+
+// static
+void CModel::defaultMethod(const CCustomMethodType::transmission_batch & batch)
+{
+  for (size_t i = 0; i < batch.size; ++i)
+    if (batch.pTransmissions[i] != NULL)
+      batch.pPropensities[i] = batch.pTransmissions[i]->propensity(batch.pEdges + i);
+}
+
 bool CModel::processTransmissions() const
 {
-  bool success = true;
-  double resolutionPerTick = 1.0 / CNetwork::timeResolution();
+  std::vector< Candidate > Candidates;
+  Batch Batch;
+  std::vector< Selection > & Selected = mSelected.Active();
+  Selected.clear();
+
+  // Counter based draws do not depend on the thread. We may therefore split all of the rank's nodes into chunks
+  // which are scheduled dynamically, since infections cluster in some partitions.
+  if (CRandom::CounterBased
+      && omp_get_num_threads() > 1)
+    {
+      CNode * pNodeBegin = CNetwork::Context.Master().beginNode();
+      size_t NodesSize = CNetwork::Context.Master().endNode() - pNodeBegin;
 
-  CRandom::uniform_real Uniform01(0.0, 1.0);
+#pragma omp for schedule(dynamic, ChunkSize)
+      for (size_t i = 0; i < NodesSize; ++i)
+        selectTransmission(pNodeBegin + i, Candidates, Batch, Selected);
+
+      // The implied barrier assures that all selections are complete. The actions must be added to the queue of
+      // the thread owning the node.
+      CNode * pNode = CNetwork::Context.Active().beginNode();
+      CNode * pNodeEnd = CNetwork::Context.Active().endNode();
+      std::vector< Selection > Owned;
+
+      const std::vector< Selection > * pIt = mSelected.beginThread();
+      const std::vector< Selection > * pEnd = mSelected.endThread();
+
+      for (; pIt != pEnd; ++pIt)
+        for (const Selection & Selection : *pIt)
+          if (pNode <= Selection.pNode && Selection.pNode < pNodeEnd)
+            Owned.push_back(Selection);
+
+      // Assure that the order of the actions does not depend on the scheduling
+      std::sort(Owned.begin(), Owned.end());
+      addTransmissions(Owned);
+
+      // No thread may clear its selections before all have been distributed.
+#pragma omp barrier
+
+      return true;
+    }
 
   CNode * pNode = CNetwork::Context.Active().beginNode();
   CNode * pNodeEnd = CNetwork::Context.Active().endNode();
 
-  struct Candidate
-  {
-    const CEdge * pEdge;
-    const CTransmission * pTransmission;
-    double Propensity;
+  for (; pNode != pNodeEnd; ++pNode)
+    selectTransmission(pNode, Candidates, Batch, Selected);
 
-    Candidate(const CEdge * edge, const CTransmission * transmission, double propensity)
-      : pEdge(edge)
-      , pTransmission(transmission)
-      , Propensity(propensity)
-    {}
-  };
+  addTransmissions(Selected);
 
-  std::vector< Candidate > Candidates;
+  return true;
+}
+
+void CModel::selectTransmission(CNode * pNode, std::vector< Candidate > & candidates, Batch & batch, std::vector< Selection > & selected) const
+{
   CTransmission ** pPossibleTransmissions = NULL;
+
+  if (pNode->susceptibility <= 0.0
+      || (pPossibleTransmissions = mPossibleTransmissions[pNode->healthState].Transmissions) == NULL)
+    return;
+
+  double resolutionPerTick = 1.0 / CNetwork::timeResolution();
   double Transmissibility = mpTransmissibility->toValue().toNumber();
+  CRandom::uniform_real Uniform01(0.0, 1.0);
 
-  for (pNode = CNetwork::Context.Active().beginNode(); pNode != pNodeEnd; ++pNode)
-    if (pNode->susceptibility > 0.0
-        && (pPossibleTransmissions = mPossibleTransmissions[pNode->healthState].Transmissions) != NULL)
-      {
-        CEdge * pEdge = pNode->Edges;
-        CEdge * pEdgeEnd = pNode->Edges + pNode->EdgesSize;
+  CEdge * pEdge = pNode->Edges;
+  CEdge * pEdgeEnd = pNode->Edges + pNode->EdgesSize;
 
-        CTransmission * pTransmission = NULL;
+  CTransmission * pTransmission = NULL;
 
-        Candidates.clear();
-        double A0 = 0.0;
+  candidates.clear();
+  double A0 = 0.0;
 
-        for (; pEdge != pEdgeEnd; ++pEdge)
-          {
-            if (pEdge->active
-                && pEdge->pSource->infectivity > 0.0
-                && (pTransmission = pPossibleTransmissions[pEdge->pSource->healthState]) != NULL)
-              {
-                double Propensity = pTransmission->propensity(pEdge);
+  if (mpCustomMethod == mpDefaultMethod)
+    {
+      // Without a custom batch method the edges' transmission propensities are computed directly.
+      for (; pEdge != pEdgeEnd; ++pEdge)
+        {
+          if (pEdge->active
+              && pEdge->pSource->infectivity > 0.0
+              && (pTransmission = pPossibleTransmissions[pEdge->pSource->healthState]) != NULL)
+            {
+              double Propensity = pTransmission->propensity(pEdge);
 
-                if (Propensity > 0.0)
-                  {
-                    A0 += Propensity;
-                    Candidates.emplace_back(pEdge, pTransmission, Propensity);
-                  }
-              }
-          }
+              if (Propensity > 0.0)
+                {
+                  A0 += Propensity;
+                  candidates.emplace_back(pEdge, pTransmission, Propensity);
+                }
+            }
+        }
+    }
+  else
+    {
+      batch.Transmissions.resize(pNode->EdgesSize);
+      batch.Infectivities.resize(pNode->EdgesSize);
+      batch.Durations.resize(pNode->EdgesSize);
+      batch.Weights.resize(pNode->EdgesSize);
+      batch.Propensities.resize(pNode->EdgesSize);
 
-        if (A0 > 0.0
-            && -log(Uniform01(CRandom::G.Active())) < A0 * Transmissibility * resolutionPerTick)
+      for (size_t i = 0; pEdge != pEdgeEnd; ++pEdge, ++i)
+        {
+          if (pEdge->active
+              && pEdge->pSource->infectivity > 0.0)
+            batch.Transmissions[i] = pPossibleTransmissions[pEdge->pSource->healthState];
+          else
+            batch.Transmissions[i] = NULL;
+
+          batch.Infectivities[i] = pEdge->pSource->infectivity;
+          batch.Durations[i] = pEdge->duration;
+          batch.Weights[i] = pEdge->weight;
+          batch.Propensities[i] = 0.0;
+        }
+
+      CCustomMethodType::transmission_batch Span;
+      Span.pTarget = pNode;
+      Span.pEdges = pNode->Edges;
+      Span.size = pNode->EdgesSize;
+      Span.pTransmissions = batch.Transmissions.data();
+      Span.pInfectivities = batch.Infectivities.data();
+      Span.pDurations = batch.Durations.data();
+      Span.pWeights = batch.Weights.data();
+      Span.pPropensities = batch.Propensities.data();
+
+      mpCustomMethod(Span);
+
+      for (size_t i = 0; i < pNode->EdgesSize; ++i)
+        if (batch.Transmissions[i] != NULL
+            && batch.Propensities[i] > 0.0)
           {
-            double alpha = Uniform01(CRandom::G.Active()) * A0;
+            A0 += batch.Propensities[i];
+            candidates.emplace_back(pNode->Edges + i, batch.Transmissions[i], batch.Propensities[i]);
+          }
+    }
 
-            std::vector< Candidate >::const_iterator itCandidate = Candidates.begin();
-            std::vector< Candidate >::const_iterator endCandidate = Candidates.end();
+  CRandom::G.Active().setStream(pNode->id, CRandom::Stream::transmission);
 
-            for (; itCandidate != endCandidate; ++itCandidate)
-              {
-                alpha -= itCandidate->Propensity;
+  if (A0 > 0.0
+      && -log(Uniform01(CRandom::G.Active())) < A0 * Transmissibility * resolutionPerTick)
+    {
+      double alpha = Uniform01(CRandom::G.Active()) * A0;
 
-                if (alpha < 0.0)
-                  break;
-              }
+      std::vector< Candidate >::const_iterator itCandidate = candidates.begin();
+      std::vector< Candidate >::const_iterator endCandidate = candidates.end();
 
-            try
-              {
-                const Candidate & Candidate = (itCandidate != endCandidate) ? *itCandidate : *Candidates.rbegin();
-                CActionQueue::addAction(0, new CTransmissionAction(Candidate.pTransmission, pNode, Candidate.pEdge));
-              }
-            catch (...)
-              {
-                CLogger::error("CModel:: Failed to create transmission for '{}'.", pNode->id);
-              }
-          }
-      }
+      for (; itCandidate != endCandidate; ++itCandidate)
+        {
+          alpha -= itCandidate->Propensity;
+
+          if (alpha < 0.0)
+            break;
+        }
 
-  return success;
+      const Candidate & Candidate = (itCandidate != endCandidate) ? *itCandidate : *candidates.rbegin();
+      selected.emplace_back(pNode, Candidate.pTransmission, Candidate.pEdge);
+    }
+}
+
+void CModel::addTransmissions(const std::vector< Selection > & selected) const
+{
+  for (const Selection & Selection : selected)
+    try
+      {
+        CActionQueue::addAction(0, new CTransmissionAction(Selection.pTransmission, Selection.pNode, Selection.pEdge));
+      }
+    catch (...)
+      {
+        CLogger::error("CModel:: Failed to create transmission for '{}'.", Selection.pNode->id);
+      }
 }
 
 // static
@@ -372,8 +482,75 @@ void CModel::StateChanged(CNode * pNode)
 void CModel::stateChanged(CNode * pNode) const
 {
   // std::cout << pNode->id << ": " << pNode->Edges << ", " << pNode->Edges + pNode->EdgesSize << ", " << pNode->EdgesSize << std::endl;
-  const CProgression * pProgression = pNode->getHealthState()->nextProgression(pNode);
+  const CHealthState * pHealthState = pNode->getHealthState();
+
+  // Counter based draws do not depend on their order. The progressions of states with a custom batch method are
+  // therefore selected in batches once the current actions have been executed.
+  if (CRandom::CounterBased
+      && pHealthState->hasCustomBatchMethod())
+    {
+      mStateChanges.Active().emplace_back(pNode, pHealthState);
+      return;
+    }
+
+  addProgression(pNode, pHealthState->nextProgression(pNode));
+}
 
+// static
+void CModel::ProcessStateChanges()
+{
+  if (INSTANCE != NULL)
+    INSTANCE->processStateChanges();
+}
+
+void CModel::processStateChanges() const
+{
+  std::vector< StateChange > & StateChanges = mStateChanges.Active();
+
+  if (StateChanges.empty())
+    return;
+
+  size_t Size = StateChanges.size();
+  std::vector< const CProgression * > Progressions(Size, NULL);
+  std::vector< bool > Done(Size, false);
+  std::vector< const CNode * > Nodes;
+  std::vector< size_t > Indexes;
+  std::vector< const CProgression * > Batch;
+
+  // The number of health states is small. We therefore collect the nodes of each state by scanning the remaining changes.
+  for (size_t i = 0; i < Size; ++i)
+    {
+      if (Done[i])
+        continue;
+
+      const CHealthState * pHealthState = StateChanges[i].pHealthState;
+      Nodes.clear();
+      Indexes.clear();
+
+      for (size_t j = i; j < Size; ++j)
+        if (StateChanges[j].pHealthState == pHealthState)
+          {
+            Nodes.push_back(StateChanges[j].pNode);
+            Indexes.push_back(j);
+            Done[j] = true;
+          }
+
+      Batch.assign(Nodes.size(), NULL);
+      pHealthState->nextProgressions(Nodes.data(), Nodes.size(), Batch.data());
+
+      for (size_t k = 0; k < Indexes.size(); ++k)
+        Progressions[Indexes[k]] = Batch[k];
+    }
+
+  // The actions are added in the order in which the states changed.
+  for (size_t i = 0; i < Size; ++i)
+    addProgression(StateChanges[i].pNode, Progressions[i]);
+
+  StateChanges.clear();
+}
+
+void CModel::addProgression(CNode * pNode, const CProgression * pProgression) const
+{
   if (pProgression != NULL)
     {
       try
@@ -574,29 +751,31 @@ bool CModel::WriteGlobalStateCounts()
         }
       else
         {
+          CFormatBuffer Line;
           std::vector< CHealthState >::iterator pState = INSTANCE->mStates.begin();
           std::vector< CHealthState >::iterator pStateEnd = INSTANCE->mStates.end();
 
-          out << CActionQueue::getCurrentTick();
+          Line << (int) CActionQueue::getCurrentTick();
 
           // Loop through all states
-          for (; pState != pStateEnd && out.good(); ++pState)
+          for (; pState != pStateEnd; ++pState)
               {
                 const CHealthState::Counts & Counts = pState->getGlobalCounts();
 
-                out << "," << Counts.Current << "," << Counts.In << "," << Counts.Out;
+                Line << ',' << Counts.Current << ',' << Counts.In << ',' << Counts.Out;
               }
 
           // We also add variables
           CVariableList::const_iterator it = CVariableList::INSTANCE.begin();
           CVariableList::const_iterator end = CVariableList::INSTANCE.end();
 
-          for (; it != end && out.good(); ++it)
+          for (; it != end; ++it)
               {
-                out << "," << (*it)->toValue().toNumber();
+                Line << ',' << (*it)->toValue().toNumber();
               }
 
-          out << "," << CRandom::getSeed() << std::endl;
+          Line << ',' << CRandom::getSeed() << '\n';
+          Line.flush(out);
         }
 
       if (out.fail())
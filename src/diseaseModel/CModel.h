@@ -32,16 +32,19 @@
 
 #include "utilities/CAnnotation.h"
 #include "utilities/CCommunicate.h"
+#include "utilities/CContext.h"
+#include "plugins/CCustomMethod.h"
 
 class CHealthState;
 class CTransmission;
 class CProgression;
 class CNode;
+class CEdge;
 class CVariable;
 
 struct json_t;
 
-class CModel: public CAnnotation
+class CModel: public CAnnotation, public CCustomMethod< CCustomMethodType::transmission_propensities >
 {
 private:
   static CModel * INSTANCE;
@@ -80,8 +83,26 @@ public:
 
   static bool ProcessTransmissions();
 
+  /**
+   * Set the batch method computing the transmission propensities of all incoming edges of a node.
+   * A custom batch method takes precedence over custom propensity methods set for the transmissions.
+   * @param CCustomMethodType::transmission_propensities pCustomMethod
+   */
+  static void SetCustomMethod(CCustomMethodType::transmission_propensities pCustomMethod);
+
+  /**
+   * The default batch method which calls the propensity method of each edge's transmission
+   * @param const CCustomMethodType::transmission_batch & batch
+   */
+  static void defaultMethod(const CCustomMethodType::transmission_batch & batch);
+
   static void StateChanged(CNode * pNode);
 
+  /**
+   * Select the progressions of the nodes whose state changed since the last call, one batch per health state
+   */
+  static void ProcessStateChanges();
+
   static const std::vector< CTransmission > & GetTransmissions();
 
   static CTransmission * GetTransmission(const std::string & id);
@@ -116,8 +137,64 @@ private:
     CTransmission ** Transmissions = nullptr;
   };
 
+  struct Candidate
+  {
+    const CEdge * pEdge;
+    const CTransmission * pTransmission;
+    double Propensity;
+
+    Candidate(const CEdge * edge, const CTransmission * transmission, double propensity)
+      : pEdge(edge)
+      , pTransmission(transmission)
+      , Propensity(propensity)
+    {}
+  };
+
+  // The properties of a node's edges gathered for a custom batch method
+  struct Batch
+  {
+    std::vector< const CTransmission * > Transmissions;
+    std::vector< double > Infectivities;
+    std::vector< double > Durations;
+    std::vector< double > Weights;
+    std::vector< double > Propensities;
+  };
+
+  struct Selection
+  {
+    CNode * pNode;
+    const CTransmission * pTransmission;
+    const CEdge * pEdge;
+
+    Selection(CNode * node, const CTransmission * transmission, const CEdge * edge)
+      : pNode(node)
+      , pTransmission(transmission)
+      , pEdge(edge)
+    {}
+
+    bool operator < (const Selection & rhs) const
+    {
+      return pNode < rhs.pNode;
+    }
+  };
+
+  struct StateChange
+  {
+    CNode * pNode;
+    const CHealthState * pHealthState;
+
+    StateChange(CNode * node, const CHealthState * healthState)
+      : pNode(node)
+      , pHealthState(healthState)
+    {}
+  };
+
   bool processTransmissions() const;
+  void selectTransmission(CNode * pNode, std::vector< Candidate > & candidates, Batch & batch, std::vector< Selection > & selected) const;
+  void addTransmissions(const std::vector< Selection > & selected) const;
   void stateChanged(CNode * pNode) const;
+  void processStateChanges() const;
+  void addProgression(CNode * pNode, const CProgression * pProgression) const;
 
   std::vector< CHealthState > mStates;
   size_t mStateCount;
@@ -129,6 +206,12 @@ private:
 
   CVariable * mpTransmissibility;
   bool mValid;
+
+  // Transmissions selected by each thread when the rank's nodes are processed in dynamically scheduled chunks
+  mutable CContext< std::vector< Selection > > mSelected;
+
+  // State changes deferred by each thread until the progressions can be selected in batches
+  mutable CContext< std::vector< StateChange > > mStateChanges;
 };
 
 #endif /* SRC_DISEASEMODEL_CMODEL_H_ */
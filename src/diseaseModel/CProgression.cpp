@@ -26,12 +26,16 @@
 
 #include "diseaseModel/CProgression.h"
 #include "diseaseModel/CHealthState.h"
+#include "network/CNode.h"
 #include "utilities/CLogger.h"
 #include "utilities/CMetadata.h"
 
 // static
-unsigned int CProgression::defaultMethod(const CProgression * pProgression, const CNode * /* pNode */)
+unsigned int CProgression::defaultMethod(const CProgression * pProgression, const CNode * pNode)
 {
+  if (pNode != NULL)
+    CRandom::G.Active().setStream(pNode->id, CRandom::Stream::dwellTime, pProgression->getExitState()->getIndex());
+
   return pProgression->mDwellTime.sample();
 }
 
@@ -304,6 +308,11 @@ unsigned int CProgression::dwellTime(const CNode * pNode) const
   return mpCustomMethod(this, pNode);
 }
 
+void CProgression::dwellTimeProbabilities(std::vector< double > & probabilities) const
+{
+  mDwellTime.probabilities(probabilities);
+}
+
 void CProgression::updateSusceptibilityFactor(double & factor) const
 {
   mSusceptibilityFactorOperation.apply(factor);
@@ -82,6 +82,8 @@ public:
 
   unsigned int dwellTime(const CNode * pNode) const;
 
+  void dwellTimeProbabilities(std::vector< double > & probabilities) const;
+
   void updateSusceptibilityFactor(double & factor) const;
 
   void updateInfectivityFactor(double & factor) const;
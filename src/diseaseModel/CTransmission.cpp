@@ -35,7 +35,7 @@
 double CTransmission::defaultMethod(const CTransmission * pTransmission, const CEdge * pEdge)
 {
   // ρ(P, P', Τi,j,k) = (| contactTime(P, P') ∩ [tn, tn + Δtn] |) × contactWeight(P, P') × σ(P, Χi) × ι(P',Χk) × ω(Τi,j,k)
-  return pEdge->duration * pEdge->weight * pEdge->pTarget->susceptibility
+  return (double) pEdge->duration * pEdge->weight * pEdge->pTarget->susceptibility
          * pEdge->pSource->infectivity * pTransmission->getTransmissibility();
 }
 
@@ -82,6 +82,9 @@ bool CTrigger::processAll()
 {
   static CDependencyGraph::UpdateOrder UpdateSequence;
 
+  // Evaluating the trigger conditions, which only compare values of already computed observables
+  // and variables, exchanging the results, and determining the update order are done by a single thread.
+  // Only the computables of the update order are evaluated concurrently.
 #pragma omp single
   {
     CLogger::setSingle(true);
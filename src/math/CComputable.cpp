@@ -114,6 +114,12 @@ void CComputable::determineIsStatic()
     }
 }
 
+// virtual
+bool CComputable::isShared() const
+{
+  return false;
+}
+
 // virtual 
 std::string CComputable::getComputableId() const
 {
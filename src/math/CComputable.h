@@ -61,6 +61,9 @@ public:
 
   virtual void determineIsStatic();
 
+  // The value of a shared computable is the same for all threads, i.e., it is computed by a single thread.
+  virtual bool isShared() const;
+
 protected:
   virtual bool computeProtected() = 0;
   
@@ -22,6 +22,7 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <algorithm>
 #include <sstream>
 
 #include "math/CDependencyNode.h"
@@ -35,6 +36,84 @@
 #include "network/CEdge.h"
 #include "network/CNode.h"
 
+// The number of nodes or edges in the chunks of a partition which are dynamically scheduled across the threads of a rank
+static const size_t ChunkSize = 1024;
+
+template < class element_type >
+struct FilterChunk
+{
+  size_t Thread;
+  element_type * pBegin;
+  element_type * pEnd;
+  std::vector< std::vector< element_type * > > Matching;
+};
+
+// Chunks are only worthwhile if each thread has several of them.
+static bool scanChunked(const size_t & size)
+{
+  return omp_get_num_threads() > 1
+         && (size_t) omp_get_num_threads() == CNetwork::Context.size()
+         && size > ChunkSize * omp_get_num_threads();
+}
+
+// Scan the elements of all partitions in chunks which are dynamically scheduled across the threads. The elements
+// matching a filter of the thread owning the partition are appended to that filter. All threads must call this with
+// filters for the same sets, which is assured since all threads evaluate the same sequence.
+template < class element_type >
+static void scanChunks(std::vector< CSetContent::Filter< element_type > > & filters,
+                       element_type * (CNetwork::*pBegin)(),
+                       element_type * (CNetwork::*pEnd)())
+{
+  static std::vector< FilterChunk< element_type > > Chunks;
+  static std::vector< std::vector< CSetContent::Filter< element_type > > * > ThreadFilters;
+
+#pragma omp single
+  {
+    Chunks.clear();
+    ThreadFilters.assign(CNetwork::Context.size(), NULL);
+
+    CNetwork * pIt = CNetwork::Context.beginThread();
+    CNetwork * pEndThread = CNetwork::Context.endThread();
+
+    for (size_t Thread = 0; pIt != pEndThread; ++pIt, ++Thread)
+      {
+        element_type * pPartition = (pIt->*pBegin)();
+        size_t Size = (pIt->*pEnd)() - pPartition;
+
+        for (size_t Offset = 0; Offset < Size; Offset += ChunkSize)
+          Chunks.push_back({Thread, pPartition + Offset, pPartition + std::min(Offset + ChunkSize, Size), {}});
+      }
+  }
+
+  ThreadFilters[omp_get_thread_num()] = &filters;
+
+#pragma omp barrier
+
+#pragma omp for schedule(dynamic, 1)
+  for (size_t i = 0; i < Chunks.size(); ++i)
+    {
+      FilterChunk< element_type > & Chunk = Chunks[i];
+      const std::vector< CSetContent::Filter< element_type > > & Owner = *ThreadFilters[Chunk.Thread];
+      Chunk.Matching.resize(Owner.size());
+
+      for (element_type * pElement = Chunk.pBegin; pElement != Chunk.pEnd; ++pElement)
+        for (size_t f = 0; f < Owner.size(); ++f)
+          if (Owner[f].matches(pElement))
+            Chunk.Matching[f].push_back(pElement);
+    }
+
+  // The chunks of a partition are in order, i.e., the appended elements remain sorted.
+  size_t Thread = omp_get_thread_num();
+
+  for (const FilterChunk< element_type > & Chunk : Chunks)
+    if (Chunk.Thread == Thread)
+      for (size_t f = 0; f < filters.size(); ++f)
+        filters[f].append(Chunk.Matching[f]);
+
+  // The chunks must not be cleared before all threads have collected their elements.
+#pragma omp barrier
+}
+
 // static
 void CDependencyGraph::buildGraph()
 {
@@ -106,70 +185,57 @@ bool CDependencyGraph::applyComputeOnceOrder()
 }
 
 // static
-bool CDependencyGraph::applyComputableSequence(CComputable::Sequence & updateSequence)
+bool CDependencyGraph::applyComputableSequence(CComputable::Sequence & updateSequence, const bool & independent)
 {
   std::vector< CSetContent::Filter< CEdge > > EdgeFilter;
   std::vector< CSetContent::Filter< CNode > > LocalNodeFilter;
   std::vector< CSetContent::Filter< CNode > > GlobalNodeFilter;
 
-  bool success = true;
+  // Property filters only depend on node and edge properties which are not modified by any 
+  // computable. They are evaluated first in a single pass over the nodes and edges. 
+  std::vector< bool > Filtered(updateSequence.size(), false);
+  std::vector< bool >::iterator itFiltered = Filtered.begin();
   CComputable::Sequence::iterator it = updateSequence.begin();
   CComputable::Sequence::iterator end = updateSequence.end();
 
-  for (; it != end && success; ++it)
+  for (; it != end; ++it, ++itFiltered)
     {
-#ifdef USE_PROCESS_GROUPS
-      if (dynamic_cast< CSetContent * >(*it))
+      CSetContent * pSetContent = dynamic_cast< CSetContent * >(*it);
+
+      if (pSetContent == NULL
+          || !pSetContent->needsCompute()
+          || pSetContent->collectorEnabled())
+        continue;
+
+      switch (pSetContent->filterType())
         {
-          if ((*it)->needsCompute())
-            {
-              CSetContent * pSetContent = static_cast< CSetContent * >(*it);
-
-              switch (pSetContent->filterType())
-                {
-                case CSetContent::FilterType::edge:
-                  {
-                    if (pSetContent && pSetContent->collectorEnabled())
-                      success &= (*it)->compute();
-                    else
-                      {
-                        CSetContent::Filter< CEdge > Filter(pSetContent);
-                        Filter.start();
-                        EdgeFilter.push_back(CSetContent::Filter< CEdge >(pSetContent));
-                        CLogger::debug("CDependencyGraph::applyComputableSequence: adding '{}' to EdgeFilter.", pSetContent->getComputableId());
-                      }
-                  }
-                  break;
-
-                case CSetContent::FilterType::node:
-                  {
-                    if (pSetContent && pSetContent->collectorEnabled())
-                      success &= (*it)->compute();
-                    else
-                      {
-                        CSetContent::Filter< CNode > Filter(pSetContent);
-                        Filter.start();
-                        LocalNodeFilter.push_back(Filter);
-
-                        if (pSetContent->getScope() == CSetContent::Scope::global)
-                          GlobalNodeFilter.push_back(Filter);
-
-                        CLogger::debug("CDependencyGraph::applyComputableSequence: adding '{}' to NodeFilter.", pSetContent->getComputableId());
-                      }
-                  }
-                  break;
-
-                case CSetContent::FilterType::none:
-                  success &= (*it)->compute();
-                  break;
-                }
-            }
+        case CSetContent::FilterType::edge:
+          {
+            CSetContent::Filter< CEdge > Filter(pSetContent);
+            Filter.start();
+            EdgeFilter.push_back(Filter);
+            *itFiltered = true;
+            CLogger::debug("CDependencyGraph::applyComputableSequence: adding '{}' to EdgeFilter.", pSetContent->getComputableId());
+          }
+          break;
+
+        case CSetContent::FilterType::node:
+          {
+            CSetContent::Filter< CNode > Filter(pSetContent);
+            Filter.start();
+            LocalNodeFilter.push_back(Filter);
+
+            if (pSetContent->getScope() == CSetContent::Scope::global)
+              GlobalNodeFilter.push_back(Filter);
+
+            *itFiltered = true;
+            CLogger::debug("CDependencyGraph::applyComputableSequence: adding '{}' to NodeFilter.", pSetContent->getComputableId());
+          }
+          break;
+
+        case CSetContent::FilterType::none:
+          break;
         }
-      else
-        success &= (*it)->compute();
-#else
-      success &= (*it)->compute();
-#endif
     }
 
   if (!EdgeFilter.empty())
@@ -177,9 +243,12 @@ bool CDependencyGraph::applyComputableSequence(CComputable::Sequence & updateSeq
       CEdge * pEdge = CNetwork::Context.Active().beginEdge();
       CEdge * pEdgeEnd = CNetwork::Context.Active().endEdge();
 
-      for (; pEdge != pEdgeEnd; ++pEdge)
-        for (CSetContent::Filter< CEdge > & filter : EdgeFilter)
-          filter.addMatching(pEdge);
+      if (scanChunked(CNetwork::Context.Master().endEdge() - CNetwork::Context.Master().beginEdge()))
+        scanChunks(EdgeFilter, &CNetwork::beginEdge, &CNetwork::endEdge);
+      else
+        for (; pEdge != pEdgeEnd; ++pEdge)
+          for (CSetContent::Filter< CEdge > & filter : EdgeFilter)
+            filter.addMatching(pEdge);
 
       for (CSetContent::Filter< CEdge > & filter : EdgeFilter)
           filter.finish();
@@ -204,9 +273,12 @@ bool CDependencyGraph::applyComputableSequence(CComputable::Sequence & updateSeq
             }
         }
 
-      for (; pNode != pNodeEnd; ++pNode)
-        for (CSetContent::Filter< CNode > & filter : LocalNodeFilter)
-          filter.addMatching(pNode);
+      if (scanChunked(CNetwork::Context.Master().endNode() - CNetwork::Context.Master().beginNode()))
+        scanChunks(LocalNodeFilter, &CNetwork::beginNode, &CNetwork::endNode);
+      else
+        for (; pNode != pNodeEnd; ++pNode)
+          for (CSetContent::Filter< CNode > & filter : LocalNodeFilter)
+            filter.addMatching(pNode);
 
       if (!GlobalNodeFilter.empty())
         {
@@ -222,6 +294,36 @@ bool CDependencyGraph::applyComputableSequence(CComputable::Sequence & updateSeq
         filter.finish();
     }
 
+  bool success = true;
+  size_t SharedCount = 0;
+  it = updateSequence.begin();
+  itFiltered = Filtered.begin();
+
+  // A thread must not stop after a failure: all threads need to encounter the same omp single
+  // constructs and the barrier below. Errors are combined by the enclosing parallel region.
+  for (; it != end; ++it, ++itFiltered)
+    if (*itFiltered)
+      continue;
+    else if (!(*it)->isShared())
+      success &= (*it)->compute();
+    else if (independent)
+      {
+        // Shared computables of a process group are distributed over the threads. 
+        if (SharedCount++ % omp_get_num_threads() == (size_t) omp_get_thread_num())
+          success &= (*it)->compute();
+      }
+    else
+      {
+#pragma omp single
+        success &= (*it)->compute();
+      }
+
+  // All threads must see the values of the shared computables before they are used.
+  if (SharedCount > 0)
+    {
+#pragma omp barrier
+    }
+
   return success;
 }
 
@@ -235,10 +337,11 @@ bool CDependencyGraph::applyUpdateOrder(CDependencyGraph::UpdateOrder & updateSe
   std::vector< CComputable::Sequence >::iterator it = updateSequence.begin();
   std::vector< CComputable::Sequence >::iterator end = updateSequence.end();
 
-  for (int level = 0; it != end && success; ++it, ++level)
+  // Every thread processes all levels since each level may end with a barrier.
+  for (int level = 0; it != end; ++it, ++level)
     {
       CLogger::debug("CDependencyGraph::applyUpdateOrder: Level[{}] size: {}.", level, it->size());
-      success &= applyComputableSequence(*it);
+      success &= applyComputableSequence(*it, true);
     }
 
 #else
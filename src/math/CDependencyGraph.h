@@ -31,7 +31,7 @@
 
 #include "math/CComputable.h"
 
-// #define USE_PROCESS_GROUPS 1
+#define USE_PROCESS_GROUPS 1
 
 class CDependencyNode;
 
@@ -60,7 +60,7 @@ public:
   static bool getUpdateOrder(UpdateOrder & updateOrder,
                              const CComputableSet & requestedComputables);
 
-  static bool applyComputableSequence(CComputable::Sequence & updateSequence);
+  static bool applyComputableSequence(CComputable::Sequence & updateSequence, const bool & independent = false);
 
   // Operations
   /**
@@ -41,6 +41,9 @@ CEdgeProperty::CEdgeProperty()
   , mpPropertyOf(NULL)
   , mpExecute(NULL)
   , mValid(false)
+#ifdef USE_REDUCED_PRECISION
+  , mNumber(0.0)
+#endif
 {}
 
 CEdgeProperty::CEdgeProperty(const CEdgeProperty & src)
@@ -49,6 +52,9 @@ CEdgeProperty::CEdgeProperty(const CEdgeProperty & src)
   , mpPropertyOf(src.mpPropertyOf)
   , mpExecute(src.mpExecute)
   , mValid(src.mValid)
+#ifdef USE_REDUCED_PRECISION
+  , mNumber(0.0)
+#endif
 {}
 
 CEdgeProperty::CEdgeProperty(const json_t * json)
@@ -57,6 +63,9 @@ CEdgeProperty::CEdgeProperty(const json_t * json)
   , mpPropertyOf(NULL)
   , mpExecute(NULL)
   , mValid(false)
+#ifdef USE_REDUCED_PRECISION
+  , mNumber(0.0)
+#endif
 {
   fromJSON(json);
 }
@@ -251,12 +260,28 @@ CValueInterface CEdgeProperty::active(CEdge * pEdge) const
 
 CValueInterface CEdgeProperty::weight(CEdge * pEdge) const
 {
+#ifdef USE_REDUCED_PRECISION
+  double & Number = mNumber.Active();
+
+  Number = pEdge->weight;
+
+  return CValueInterface(Number);
+#else
   return CValueInterface(pEdge->weight);
+#endif
 }
 
 CValueInterface CEdgeProperty::duration(CEdge * pEdge) const
 {
+#ifdef USE_REDUCED_PRECISION
+  double & Number = mNumber.Active();
+
+  Number = pEdge->duration;
+
+  return CValueInterface(Number);
+#else
   return CValueInterface(pEdge->duration);
+#endif
 }
 
 bool CEdgeProperty::setTargetId(CEdge * pEdge, const CValueInterface & /* value */, CValueInterface::pOperator /* pOperator */, const CMetadata & /* info */)
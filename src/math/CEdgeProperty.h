@@ -27,8 +27,10 @@
 
 #include <memory>
 
+#include "EpiHiperConfig.h"
 #include "math/CValueInterface.h"
 #include "math/CNodeProperty.h"
+#include "utilities/CContext.h"
 
 class CEdge;
 struct COperation;
@@ -113,6 +115,11 @@ private:
   CValueInterface (CEdgeProperty::*mpPropertyOf)(CEdge *) const;
   bool (CEdgeProperty::*mpExecute)(CEdge *, const CValueInterface &, CValueInterface::pOperator pOperator, const CMetadata & info);
   bool mValid;
+
+#ifdef USE_REDUCED_PRECISION
+  // The double precision value of the reduced precision edge attributes
+  mutable CContext< double > mNumber;
+#endif
 };
 
 #endif /* SRC_MATH_CEDGEPROPERTY_H_ */
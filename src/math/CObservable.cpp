@@ -132,19 +132,18 @@ void CObservable::determineIsStatic()
   mStatic = (mObservableType == ObservableType::totalPopulation);
 }
 
+// virtual
+bool CObservable::isShared() const
+{
+  return true;
+}
+
 // virtual
 bool CObservable::computeProtected()
 {
   if (isValid()
       && mpCompute != NULL)
-    {
-      bool success = true;
-
-#pragma omp single
-      success = (this->*mpCompute)();
-
-      return success;
-    }
+    return (this->*mpCompute)();
 
   return false;
 }
@@ -76,6 +76,8 @@ public:
 
   virtual void determineIsStatic() override;
 
+  virtual bool isShared() const override;
+
 protected:
   virtual bool computeProtected() override;
 
@@ -24,6 +24,7 @@
 
 #include "math/CValueList.h"
 
+#include <algorithm>
 #include <jansson.h>
 
 #include "traits/CTrait.h"
@@ -34,18 +35,36 @@ CValueList::CValueList(const Type & type)
   : std::set< CValue >()
   , mType(type)
   , mValid(true)
+  , mIndex(Index::none)
+  , mBitmask(0)
+  , mFeature(0)
+  , mFeatureShift(0)
+  , mSortedIds()
+  , mSortedNumbers()
 {}
 
 CValueList::CValueList(const CValueList & src)
   : std::set< CValue >(src)
   , mType(src.mType)
   , mValid(src.mValid)
+  , mIndex(src.mIndex)
+  , mBitmask(src.mBitmask)
+  , mFeature(src.mFeature)
+  , mFeatureShift(src.mFeatureShift)
+  , mSortedIds(src.mSortedIds)
+  , mSortedNumbers(src.mSortedNumbers)
 {}
 
 CValueList::CValueList(const json_t * json)
   : std::set< CValue >()
   , mType()
   , mValid(true)
+  , mIndex(Index::none)
+  , mBitmask(0)
+  , mFeature(0)
+  , mFeatureShift(0)
+  , mSortedIds()
+  , mSortedNumbers()
 {
   fromJSON(json);
 }
@@ -54,6 +73,12 @@ CValueList::CValueList(std::istream & is)
   : std::set< CValue >()
   , mType()
   , mValid(true)
+  , mIndex(Index::none)
+  , mBitmask(0)
+  , mFeature(0)
+  , mFeatureShift(0)
+  , mSortedIds()
+  , mSortedNumbers()
 {
   fromBinary(is);
 }
@@ -69,12 +94,16 @@ bool CValueList::append(const CValue & value)
     return false;
 
   std::set< CValue >::insert(value);
+  mIndex = Index::none;
 
   return true;
 }
 
 bool CValueList::contains(const CValueInterface & value) const
 {
+  if (mIndex != Index::none)
+    return indexContains(value);
+
   // Convert CValueInterface::Type::traitData to CValueInterface::Type::value
   if (value.getType() == CValueInterface::Type::traitData 
       && !empty())
@@ -404,6 +433,7 @@ void CValueList::fromJSON(const json_t * json)
     }
 
   mValid = true;
+  buildIndex();
 }
 
 void CValueList::toBinary(std::ostream & os) const
@@ -507,13 +537,175 @@ void CValueList::fromBinary(std::istream & is)
     case Type::__SIZE:
       break;
     }
+
+  buildIndex();
 }
 
 CValueList::iterator CValueList::insert(CValueList::iterator position, const CValueList::value_type & val)
 {
+  mIndex = Index::none;
+
   return std::set< CValue >::insert(position, val);
 }
 
+void CValueList::clear()
+{
+  mIndex = Index::none;
+  std::set< CValue >::clear();
+}
+
+CValueList::iterator CValueList::erase(CValueList::const_iterator position)
+{
+  mIndex = Index::none;
+  return std::set< CValue >::erase(position);
+}
+
+size_t CValueList::erase(const CValueList::value_type & val)
+{
+  mIndex = Index::none;
+  return std::set< CValue >::erase(val);
+}
+
+CValueList::iterator CValueList::erase(CValueList::const_iterator first, CValueList::const_iterator last)
+{
+  mIndex = Index::none;
+  return std::set< CValue >::erase(first, last);
+}
+
+void CValueList::buildIndex()
+{
+  mIndex = Index::none;
+  mBitmask = 0;
+  mSortedIds.clear();
+  mSortedNumbers.clear();
+
+  // The values are iterated in order, i.e., the sorted vectors need no sorting.
+  switch (mType)
+    {
+    case Type::boolean:
+      for (const CValue & Value : *this)
+        mBitmask |= uint64_t(1) << Value.toBoolean();
+
+      mIndex = Index::bitmask;
+      break;
+
+    case Type::number:
+      for (const CValue & Value : *this)
+        mSortedNumbers.push_back(Value.toNumber());
+
+      mIndex = Index::sorted;
+      break;
+
+    case Type::integer:
+      for (const CValue & Value : *this)
+        mSortedNumbers.push_back(Value.toInteger());
+
+      mIndex = Index::sorted;
+      break;
+
+    case Type::id:
+      // Health states and other small ids are represented by a bitmask.
+      if (empty() || rbegin()->toId() < 64)
+        {
+          for (const CValue & Value : *this)
+            mBitmask |= uint64_t(1) << Value.toId();
+
+          mIndex = Index::bitmask;
+        }
+      else
+        {
+          for (const CValue & Value : *this)
+            mSortedIds.push_back(Value.toId());
+
+          mIndex = Index::sorted;
+        }
+      break;
+
+    case Type::traitValue:
+      // All values belong to the same feature. The bitmask is indexed by the value of the feature if it has at most 64 values.
+      if (!empty()
+          && begin()->toTraitValue().first != 0)
+        {
+          mFeature = begin()->toTraitValue().first;
+          mFeatureShift = 0;
+
+          while (((mFeature >> mFeatureShift) & 1) == 0)
+            ++mFeatureShift;
+
+          if ((mFeature >> mFeatureShift) < 64)
+            {
+              mIndex = Index::bitmask;
+
+              for (const CValue & Value : *this)
+                if (Value.toTraitValue().first != mFeature
+                    || (Value.toTraitValue().second & ~mFeature) != 0)
+                  {
+                    mIndex = Index::none;
+                    break;
+                  }
+                else
+                  mBitmask |= uint64_t(1) << (Value.toTraitValue().second >> mFeatureShift);
+            }
+        }
+      break;
+
+    case Type::string:
+    case Type::traitData:
+    case Type::__SIZE:
+      break;
+    }
+}
+
+bool CValueList::indexContains(const CValueInterface & value) const
+{
+  switch (value.getType())
+    {
+    case Type::boolean:
+      return mType == Type::boolean
+             && ((mBitmask >> value.toBoolean()) & 1);
+      break;
+
+    case Type::number:
+      return mType == Type::number
+             && std::binary_search(mSortedNumbers.begin(), mSortedNumbers.end(), value.toNumber());
+      break;
+
+    case Type::integer:
+      return mType == Type::integer
+             && std::binary_search(mSortedNumbers.begin(), mSortedNumbers.end(), (double) value.toInteger());
+      break;
+
+    case Type::id:
+      if (mType != Type::id)
+        return false;
+
+      if (mIndex == Index::bitmask)
+        return value.toId() < 64
+               && ((mBitmask >> value.toId()) & 1);
+
+      return std::binary_search(mSortedIds.begin(), mSortedIds.end(), value.toId());
+      break;
+
+    case Type::traitData:
+      return mType == Type::traitValue
+             && ((mBitmask >> ((value.toTraitData() & mFeature) >> mFeatureShift)) & 1);
+      break;
+
+    case Type::traitValue:
+      return mType == Type::traitValue
+             && value.toTraitValue().first == mFeature
+             && ((value.toTraitValue().second & ~mFeature) == 0)
+             && ((mBitmask >> (value.toTraitValue().second >> mFeatureShift)) & 1);
+      break;
+
+    case Type::string:
+    case Type::__SIZE:
+      break;
+    }
+
+  return false;
+}
+
 std::ostream & operator << (std::ostream & os, const CValueList & p)
 {
   bool first = true;
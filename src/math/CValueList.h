@@ -25,7 +25,10 @@
 #ifndef SRC_MATH_CVALUELIST_H_
 #define SRC_MATH_CVALUELIST_H_
 
+#include <cstdint>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "math/CValue.h"
 
@@ -74,15 +77,53 @@ public:
 
   template < typename _InputIterator > void insert(_InputIterator __first, _InputIterator __last);
 
+  template < typename... _Args > std::pair< iterator, bool > emplace(_Args &&... __args);
+
+  // All modifications of the set invalidate the index
+  void clear();
+
+  iterator erase(const_iterator position);
+
+  size_t erase(const value_type & val);
+
+  iterator erase(const_iterator first, const_iterator last);
+
 protected:
   Type mType;
   bool mValid;
+
+private:
+  // The flat representation used for membership tests, which is built for complete lists
+  enum struct Index
+  {
+    none,
+    bitmask,
+    sorted
+  };
+
+  void buildIndex();
+
+  bool indexContains(const CValueInterface & value) const;
+
+  Index mIndex;
+  uint64_t mBitmask;
+  CTraitData::base mFeature;
+  size_t mFeatureShift;
+  std::vector< size_t > mSortedIds;
+  std::vector< double > mSortedNumbers;
 };
 
 template < typename _InputIterator > void CValueList::insert(_InputIterator __first, _InputIterator __last)
 {
+  mIndex = Index::none;
   base::insert(__first, __last);
 }
 
+template < typename... _Args > std::pair< CValueList::iterator, bool > CValueList::emplace(_Args &&... __args)
+{
+  mIndex = Index::none;
+  return base::emplace(std::forward< _Args >(__args)...);
+}
+
 
 #endif /* SRC_MATH_CVALUELIST_H_ */
@@ -22,11 +22,30 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <cstdint>
+
 #include "network/CEdge.h"
 #include "traits/CTrait.h"
 #include "utilities/CMetadata.h"
 #include "utilities/CLogger.h"
 
+// The binary data of an edge with the PID type of the network. The duration and weight are always
+// stored in double precision.
+template < class Id > struct BinaryRecord
+{
+  Id targetId;
+  CTraitData::base targetActivity;
+  Id sourceId;
+  CTraitData::base sourceActivity;
+  double duration;
+#ifdef USE_LOCATION_ID
+  size_t locationId;
+#endif
+  CTraitData::base edgeTrait;
+  bool active;
+  double weight;
+};
+
 // static
 CEdge CEdge::getDefault()
 {
@@ -50,6 +69,19 @@ CEdge CEdge::getDefault()
 }
 
 CEdge::CEdge()
+#ifdef USE_REDUCED_PRECISION
+  : targetId(std::numeric_limits< size_t >::max())
+  , sourceId(std::numeric_limits< size_t >::max())
+#ifdef USE_LOCATION_ID
+  , locationId(std::numeric_limits< size_t >::max())
+#endif
+  , targetActivity()
+  , sourceActivity()
+  , edgeTrait()
+  , duration(0.0)
+  , weight(1.0)
+  , active(true)
+#else
   : targetId(std::numeric_limits< size_t >::max())
   , targetActivity()
   , sourceId(std::numeric_limits< size_t >::max())
@@ -61,6 +93,7 @@ CEdge::CEdge()
   , edgeTrait()
   , active(true)
   , weight(1.0)
+#endif
   , pTarget(NULL)
   , pSource(NULL)
 {}
@@ -68,57 +101,109 @@ CEdge::CEdge()
 CEdge::~CEdge()
 {}
 
-void CEdge::toBinary(std::ostream & os) const
+// The binary data is written from targetId to weight. The location id is skipped if it is not part of the network.
+template < class Data > static void writeBinary(const Data & data, std::ostream & os)
 {
+  const char * pBegin = reinterpret_cast< const char * >(&data.targetId);
+  const char * pEnd = reinterpret_cast< const char * >(&data.weight + 1);
+
 #ifdef USE_LOCATION_ID
-  if (CEdge::HasLocationId)
-    os.write(reinterpret_cast< const char * >(&targetId), 64);
-  else
+  if (!CEdge::HasLocationId)
     {
-      os.write(reinterpret_cast< const char * >(&targetId), 40);
-      os.write(reinterpret_cast< const char * >(&edgeTrait), 16);
+      const char * pLocationId = reinterpret_cast< const char * >(&data.locationId);
+      const char * pEdgeTrait = reinterpret_cast< const char * >(&data.edgeTrait);
+
+      os.write(pBegin, pLocationId - pBegin);
+      os.write(pEdgeTrait, pEnd - pEdgeTrait);
+
+      return;
     }
-#else
-  os.write(reinterpret_cast< const char * >(&targetId), 56);
 #endif
-  /*
-  os.write(reinterpret_cast<const char *>(&targetId), sizeof(size_t));
-  os.write(reinterpret_cast<const char *>(&targetActivity), sizeof(CTraitData::base));
-  os.write(reinterpret_cast<const char *>(&sourceId), sizeof(size_t));
-  os.write(reinterpret_cast<const char *>(&sourceActivity), sizeof(CTraitData::base));
-  os.write(reinterpret_cast<const char *>(&duration), sizeof(double));
-  os.write(reinterpret_cast<const char *>(&locationId), sizeof(size_t));
-  os.write(reinterpret_cast<const char *>(&edgeTrait), sizeof(CTraitData::base));
-  os.write(reinterpret_cast<const char *>(&active), sizeof(char));
-  os.write(reinterpret_cast<const char *>(&weight), sizeof(double));
-  */
+
+  os.write(pBegin, pEnd - pBegin);
 }
 
-void CEdge::fromBinary(std::istream & is)
+template < class Data > static void readBinary(Data & data, std::istream & is)
 {
+  char * pBegin = reinterpret_cast< char * >(&data.targetId);
+  char * pEnd = reinterpret_cast< char * >(&data.weight + 1);
+
 #ifdef USE_LOCATION_ID
-  if (CEdge::HasLocationId)
-    is.read(reinterpret_cast< char * >(&targetId), 64);
-  else
+  if (!CEdge::HasLocationId)
     {
-      is.read(reinterpret_cast< char * >(&targetId), 40);
-      is.read(reinterpret_cast< char * >(&edgeTrait), 16);
+      char * pLocationId = reinterpret_cast< char * >(&data.locationId);
+      char * pEdgeTrait = reinterpret_cast< char * >(&data.edgeTrait);
+
+      is.read(pBegin, pLocationId - pBegin);
+      is.read(pEdgeTrait, pEnd - pEdgeTrait);
+
+      return;
     }
+#endif
+
+  is.read(pBegin, pEnd - pBegin);
+}
+
+template < class Record > static void writeRecord(const CEdge & edge, std::ostream & os)
+{
+  Record Data;
+
+  Data.targetId = edge.targetId;
+  Data.targetActivity = edge.targetActivity;
+  Data.sourceId = edge.sourceId;
+  Data.sourceActivity = edge.sourceActivity;
+  Data.duration = edge.duration;
+#ifdef USE_LOCATION_ID
+  Data.locationId = edge.locationId;
+#endif
+  Data.edgeTrait = edge.edgeTrait;
+  Data.active = edge.active;
+  Data.weight = edge.weight;
+
+  writeBinary(Data, os);
+}
+
+template < class Record > static void readRecord(CEdge & edge, std::istream & is)
+{
+  Record Data;
+
+  readBinary(Data, is);
+
+  edge.targetId = Data.targetId;
+  edge.targetActivity = Data.targetActivity;
+  edge.sourceId = Data.sourceId;
+  edge.sourceActivity = Data.sourceActivity;
+  edge.duration = Data.duration;
+#ifdef USE_LOCATION_ID
+  edge.locationId = Data.locationId;
+#endif
+  edge.edgeTrait = Data.edgeTrait;
+  edge.active = Data.active;
+  edge.weight = Data.weight;
+}
+
+void CEdge::toBinary(std::ostream & os, const size_t & sizeOfPid) const
+{
+  if (sizeOfPid == sizeof(uint32_t))
+    writeRecord< BinaryRecord< uint32_t > >(*this, os);
+  else
+#ifdef USE_REDUCED_PRECISION
+    writeRecord< BinaryRecord< size_t > >(*this, os);
 #else
-  is.read(reinterpret_cast< char * >(&targetId), 56);
+    writeBinary(*this, os);
 #endif
+}
 
-  /*
-  is.read(reinterpret_cast<char *>(&targetId), sizeof(size_t));
-  is.read(reinterpret_cast<char *>(&targetActivity), sizeof(CTraitData::base));
-  is.read(reinterpret_cast<char *>(&sourceId), sizeof(size_t));
-  is.read(reinterpret_cast<char *>(&sourceActivity), sizeof(CTraitData::base));
-  is.read(reinterpret_cast<char *>(&duration), sizeof(double));
-  is.read(reinterpret_cast<char *>(&locationId), sizeof(size_t));
-  is.read(reinterpret_cast<char *>(&edgeTrait), sizeof(CTraitData::base));
-  is.read(reinterpret_cast<char *>(&active), sizeof(char));
-  is.read(reinterpret_cast<char *>(&weight), sizeof(double));
-  */
+void CEdge::fromBinary(std::istream & is, const size_t & sizeOfPid)
+{
+  if (sizeOfPid == sizeof(uint32_t))
+    readRecord< BinaryRecord< uint32_t > >(*this, is);
+  else
+#ifdef USE_REDUCED_PRECISION
+    readRecord< BinaryRecord< size_t > >(*this, is);
+#else
+    readBinary(*this, is);
+#endif
 }
 
 bool CEdge::setTargetActivity(const CTraitData::value & value, CValueInterface::pOperator ENABLE_TRACE(pOperator), const CMetadata & ENABLE_TRACE(metadata))
@@ -180,7 +265,14 @@ bool CEdge::setWeight(const double & value, CValueInterface::pOperator pOperator
                               sourceId,
                               CValueInterface::operatorToString(pOperator),
                               value););
+#ifdef USE_REDUCED_PRECISION
+  double Weight = weight;
+
+  (*pOperator)(Weight, value);
+  weight = Weight;
+#else
   (*pOperator)(weight, value);
+#endif
 
   return true;
 }
@@ -37,6 +37,12 @@ class CMetadata;
 class CEdge
 {
 public:
+#ifdef USE_REDUCED_PRECISION
+  typedef float real;
+#else
+  typedef double real;
+#endif
+
   static bool HasLocationId;
   static bool HasEdgeTrait;
   static bool HasActiveField;
@@ -44,10 +50,12 @@ public:
   static CEdge getDefault();
 
   CEdge();
-  virtual ~CEdge();
+  // Edges are never derived from, i.e., they do not carry a vtable
+  ~CEdge();
 
-  void toBinary(std::ostream & os) const;
-  void fromBinary(std::istream & is);
+  // The person ids of binary records are encoded with the given size (4 or 8 bytes)
+  void toBinary(std::ostream & os, const size_t & sizeOfPid) const;
+  void fromBinary(std::istream & is, const size_t & sizeOfPid);
 
   bool setTargetActivity(const CTraitData::value & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
   bool setSourceActivity(const CTraitData::value & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
@@ -55,19 +63,34 @@ public:
   bool setActive(const bool & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
   bool setWeight(const double & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
 
+#ifdef USE_REDUCED_PRECISION
+  // The members are ordered by size. The binary data is converted to and from the double precision records.
+  size_t targetId;
+  size_t sourceId;
+#ifdef USE_LOCATION_ID
+  size_t locationId;
+#endif
+  CTraitData::base targetActivity;
+  CTraitData::base sourceActivity;
+  CTraitData::base edgeTrait;
+  real duration;
+  real weight;
+  bool active;
+#else
   // start binary data
   size_t targetId;
   CTraitData::base targetActivity;
   size_t sourceId;
   CTraitData::base sourceActivity;
-  double duration;
+  real duration;
 #ifdef USE_LOCATION_ID
   size_t locationId;
 #endif
   CTraitData::base edgeTrait;
   bool active;
-  double weight;
+  real weight;
   // end binary data
+#endif
 
   CNode * pTarget;
   CNode * pSource;
@@ -43,15 +43,159 @@
 
 #include "utilities/CSimConfig.h"
 #include "utilities/CDirEntry.h"
+#include "utilities/CMemory.h"
 #include "network/CNode.h"
 #include "CNetwork.h"
 
+// The optional edge columns of a network. Each schema is a separate specialization, i.e., columns which are
+// not present cost no branches.
+template < bool LocationId, bool EdgeTrait, bool Active, bool Weight > struct EdgeSchema
+{
+  static bool read(CEdge * pEdge, const char *& ptr);
+  static void write(const CEdge * pEdge, CFormatBuffer & buffer);
+};
+
+template < bool LocationId, bool EdgeTrait, bool Active, bool Weight >
+bool EdgeSchema< LocationId, EdgeTrait, Active, Weight >::read(CEdge * pEdge, const char *& ptr)
+{
+  int Read = 0;
+
+  // The remaining columns cannot be parsed once a column is missing or malformed.
+#ifdef USE_LOCATION_ID
+  if (LocationId)
+    {
+      if (1 != sscanf(ptr, ",%zu%n", &pEdge->locationId, &Read))
+        return false;
+
+      ptr += Read;
+    }
+#endif
+
+  if (EdgeTrait)
+    {
+      char edgeTrait[128];
+
+      if (1 != sscanf(ptr, ",%127[^,]%n", edgeTrait, &Read))
+        return false;
+
+      CTrait::EdgeTrait->fromString(edgeTrait, pEdge->edgeTrait);
+      ptr += Read;
+    }
+
+  if (Active)
+    {
+      char Flag;
+
+      if (1 != sscanf(ptr, ",%c%n", &Flag, &Read))
+        return false;
+
+      pEdge->active = (Flag == '1');
+      ptr += Read;
+    }
+
+  if (Weight)
+    {
+      double Value;
+
+      if (1 != sscanf(ptr, ",%lf%n", &Value, &Read))
+        return false;
+
+      pEdge->weight = Value;
+      ptr += Read;
+    }
+
+  return true;
+}
+
+template < bool LocationId, bool EdgeTrait, bool Active, bool Weight >
+void EdgeSchema< LocationId, EdgeTrait, Active, Weight >::write(const CEdge * pEdge, CFormatBuffer & buffer)
+{
+#ifdef USE_LOCATION_ID
+  if (LocationId)
+    {
+      buffer << ',' << pEdge->locationId;
+    }
+#endif
+
+  if (EdgeTrait)
+    {
+      buffer << ',' << CTrait::EdgeTrait->toString(pEdge->edgeTrait);
+    }
+
+  if (Active)
+    {
+      buffer << ',' << pEdge->active;
+    }
+
+  if (Weight)
+    {
+      buffer << ',' << pEdge->weight;
+    }
+}
+
+template < bool LocationId, bool EdgeTrait, bool Active >
+static void selectWeight(CNetwork::ReadEdgeColumns & read, CNetwork::WriteEdgeColumns & write)
+{
+  if (CEdge::HasWeightField)
+    {
+      read = &EdgeSchema< LocationId, EdgeTrait, Active, true >::read;
+      write = &EdgeSchema< LocationId, EdgeTrait, Active, true >::write;
+    }
+  else
+    {
+      read = &EdgeSchema< LocationId, EdgeTrait, Active, false >::read;
+      write = &EdgeSchema< LocationId, EdgeTrait, Active, false >::write;
+    }
+}
+
+template < bool LocationId, bool EdgeTrait >
+static void selectActive(CNetwork::ReadEdgeColumns & read, CNetwork::WriteEdgeColumns & write)
+{
+  if (CEdge::HasActiveField)
+    selectWeight< LocationId, EdgeTrait, true >(read, write);
+  else
+    selectWeight< LocationId, EdgeTrait, false >(read, write);
+}
+
+template < bool LocationId >
+static void selectEdgeTrait(CNetwork::ReadEdgeColumns & read, CNetwork::WriteEdgeColumns & write)
+{
+  if (CEdge::HasEdgeTrait)
+    selectActive< LocationId, true >(read, write);
+  else
+    selectActive< LocationId, false >(read, write);
+}
+
+// static
+CNetwork::ReadEdgeColumns CNetwork::ReadColumns(&EdgeSchema< false, false, false, false >::read);
+
+// static
+CNetwork::WriteEdgeColumns CNetwork::WriteColumns(&EdgeSchema< false, false, false, false >::write);
+
+// static
+void CNetwork::selectEdgeSchema()
+{
+#ifdef USE_LOCATION_ID
+  if (CEdge::HasLocationId)
+    selectEdgeTrait< true >(ReadColumns, WriteColumns);
+  else
+    selectEdgeTrait< false >(ReadColumns, WriteColumns);
+#else
+  selectEdgeTrait< false >(ReadColumns, WriteColumns);
+#endif
+}
+
 // static
 void CNetwork::init(const std::string & networkFile)
 {
   CChanges::init();
   Context.init();
 
+  CMemory::setHugePages(CSimConfig::getHugePages());
+
+  if (CCommunicate::MPIRank == 0)
+    CMemory::logLayout();
+
   Context.Master().loadJsonPreamble(networkFile);
   Context.Master().partition(CCommunicate::TotalProcesses(), false);
 }
@@ -139,6 +283,9 @@ CNetwork::CNetwork()
   , mBeyondLocalNode(0)
   , mLocalNodesSize(0)
   , mRemoteNodes()
+  , mRemoteNodeIndex()
+  , mLocalNodeIndex()
+  , mEdgeIndex()
   , mSourceOnlyNodes()
   , mNodes(NULL)
   , mNodesSize(0)
@@ -147,12 +294,19 @@ CNetwork::CNetwork()
   , mTotalNodesSize(0)
   , mTotalEdgesSize(0)
   , mTotalNodeRange({std::numeric_limits< size_t >::max(), 0})
+  , mSharedWindow()
+  , mpSharedNodes(NULL)
+  , mSharedSequence(0)
+  , mSharedRanks()
+  , mSharedRemoteNodes()
   , mSizeOfPid(0)
+  , mBinarySizeOfPid(sizeof(size_t))
   , mAccumulationTime()
   , mTimeResolution(0)
   , mIsBinary(false)
   , mValid(false)
   , mpJson(NULL)
+  , mWriteBuffer()
   , mDumpActiveNetwork()
 {}
 
@@ -182,16 +336,25 @@ CNetwork::~CNetwork()
       json_decref(mpJson);
     }
 
+#ifdef USE_MPI
+  if (mpSharedNodes != NULL)
+    {
+      MPI_Win_unlock_all(mSharedWindow);
+      MPI_Win_free(&mSharedWindow);
+      mpSharedNodes = NULL;
+    }
+#endif // USE_MPI
+
   // This data is owned by master;
   if (mNodes != NULL)
     {
-      delete[] mNodes;
+      CMemory::release(mNodes, mNodesSize);
       mNodes = NULL;
     }
 
   if (mEdges != NULL)
     {
-      delete[] mEdges;
+      CMemory::release(mEdges, mEdgesSize);
       mEdges = NULL;
     }
 }
@@ -244,6 +407,14 @@ void CNetwork::fromJSON(const json_t * json)
       "description": "The size of the person Id (PID) in bytes",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
+    "sizeofBinaryPID": {
+      "description": "The size of the person Id (PID) in bytes in binary edges (Default: 8).",
+      "type": "integer",
+      "enum": [
+        4,
+        8
+      ]
+    },
     "accumulationTime": {
       "description": "An annotation string describing the accumulation time for the contact",
       "type": "string"
@@ -329,6 +500,14 @@ void CNetwork::fromJSON(const json_t * json)
         "beyondLocalNode": {
           "description": "The number of the first node beyond the local nodes",
           "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "edgePrecision": {
+          "description": "The precision of the edge duration and weight in the partition (Default: double)",
+          "type": "string",
+          "enum": [
+            "single",
+            "double"
+          ]
         }
       }
     },
@@ -395,6 +574,24 @@ void CNetwork::fromJSON(const json_t * json)
       return;
     }
 
+  CNode::SizeOfPid = mSizeOfPid;
+
+  // Binary networks without this field use 8 byte person ids independent of sizeofPID.
+  pValue = json_object_get(json, "sizeofBinaryPID");
+  mBinarySizeOfPid = sizeof(size_t);
+
+  if (json_is_integer(pValue))
+    {
+      mBinarySizeOfPid = json_integer_value(pValue);
+
+      if (mBinarySizeOfPid != 4
+          && mBinarySizeOfPid != 8)
+        {
+          CLogger::error("Network: Invalid 'sizeofBinaryPID'.");
+          return;
+        }
+    }
+
   // This is only annotation for know.
   pValue = json_object_get(json, "accumulationTime");
 
@@ -511,6 +708,8 @@ void CNetwork::fromJSON(const json_t * json)
       CEdge::HasWeightField = json_boolean_value(pValue);
     }
 
+  selectEdgeSchema();
+
   pValue = json_object_get(json, "sourceOnlyNodes");
 
   if (json_is_array(pValue))
@@ -631,7 +830,7 @@ void CNetwork::convert(std::istream & is, const std::string & outputDirectory)
 
       while (is.good() && loadEdge(&Edge, is))
         {
-          Edge.toBinary(os);
+          Edge.toBinary(os, mSizeOfPid);
         }
 
       os.close();
@@ -771,7 +970,7 @@ void CNetwork::partition(std::istream & is, const int & parts, const bool & save
             }
 
           // Write edge to current node buffer
-          Edge.toBinary(NodeBuffer);
+          Edge.toBinary(NodeBuffer, mSizeOfPid);
 
           ++*pEdges;
           ++PartitionEdgeCount;
@@ -925,11 +1124,23 @@ void CNetwork::load()
             Active.mValid = false;
           }
 
+        pValue = json_object_get(pJson, "sizeofBinaryPID");
+
+        if (json_is_integer(pValue))
+          {
+            Active.mBinarySizeOfPid = json_integer_value(pValue);
+          }
+        else
+          {
+            Active.mBinarySizeOfPid = sizeof(size_t);
+          }
+
         json_decref(pJson);
       }
     else
       {
         Active.mFile = mFile;
+        Active.mBinarySizeOfPid = mBinarySizeOfPid;
       }
 
     if (Context.isThread(&Active))
@@ -947,7 +1158,8 @@ void CNetwork::load()
 
   try
     {
-      mEdges = new CEdge[mEdgesSize];
+      // The edges are constructed by the thread owning them to place them on its NUMA domain.
+      mEdges = CMemory::allocate< CEdge >(mEdgesSize);
     }
 
   catch (...)
@@ -1013,6 +1225,8 @@ void CNetwork::load()
     CEdge * pEdgeEnd = pEdge + Active.mEdgesSize;
     CEdge DefaultEdge = CEdge::getDefault();
 
+    CMemory::construct(pEdge, pEdgeEnd);
+
     while (is.good() && pEdge < pEdgeEnd)
       {
         *pEdge = DefaultEdge;
@@ -1085,6 +1299,8 @@ void CNetwork::load()
 
   initNodes();
 
+  mEdgeIndex.resize(mEdgesSize);
+
 #pragma omp parallel
   {
     CNetwork & Active = Context.Active();
@@ -1125,6 +1341,9 @@ void CNetwork::load()
 
         pNode->Edges = pEdge;
       }
+
+    for (pNode = Active.beginNode(); pNode != pNodeEnd; ++pNode)
+      indexEdges(pNode);
   }
 
   initOutgoingEdges();
@@ -1141,7 +1360,8 @@ void CNetwork::initNodes()
 
   try
     {
-      mNodes = new CNode[mNodesSize];
+      // The nodes are constructed by the thread owning them to place them on its NUMA domain.
+      mNodes = CMemory::allocate< CNode >(mNodesSize);
     }
 
   catch (...)
@@ -1172,7 +1392,7 @@ void CNetwork::initNodes()
       for (it = mRemoteNodes.begin(); it != end && it->first < mFirstLocalNode; ++it, ++pNode)
 #pragma omp task
         {
-          *pNode = DefaultNode;
+          new (pNode) CNode(DefaultNode);
           pNode->id = it->first;
           it->second = pNode;
           // ENABLE_TRACE(CLogger::trace("CNetwork::initNodes: Master.mRemoteNodes[{}]: {}",  it->first, (void *) it->second););
@@ -1183,7 +1403,7 @@ void CNetwork::initNodes()
       for (; it != end; ++it, ++pNode)
 #pragma omp task
         {
-          *pNode = DefaultNode;
+          new (pNode) CNode(DefaultNode);
           pNode->id = it->first;
           it->second = pNode;
           // ENABLE_TRACE(CLogger::trace("CNetwork::initNodes: Master.mRemoteNodes[{}]: {}", it->first, (void *) it->second););
@@ -1201,20 +1421,43 @@ void CNetwork::initNodes()
         pNode += pIt->mLocalNodesSize;
       }
 
+  // Remote nodes are found through a flat hash map
+  mRemoteNodeIndex.init(mRemoteNodes.size());
+
+  for (const std::pair< const size_t, CNode * > & Remote : mRemoteNodes)
+    mRemoteNodeIndex.insert(Remote.first, Remote.second);
+
+  // If the ids are dense the local nodes are indexed directly
+  mLocalNodeIndex.clear();
+
+  if (mLocalNodesSize > 0
+      && mBeyondLocalNode - mFirstLocalNode <= 2 * mLocalNodesSize)
+    mLocalNodeIndex.resize(mBeyondLocalNode - mFirstLocalNode, NULL);
+
+  CLogger::info("Network: Local node index '{}' ({} bytes), remote nodes '{}'.", mLocalNodeIndex.size(), mLocalNodeIndex.size() * sizeof(CNode *), mRemoteNodeIndex.size());
+
 #pragma omp parallel
   {
     CNetwork & Active = Context.Active();
     CNode * pNode = Active.beginNode();
+    bool Indexed = !mLocalNodeIndex.empty();
     
     for (const size_t & Id : Active.mLocalNodeIds)
       {
-        *pNode = DefaultNode;
+        new (pNode) CNode(DefaultNode);
         pNode->id = Id;
+
+        if (Indexed)
+          mLocalNodeIndex[Id - mFirstLocalNode] = pNode;
+
         ++pNode;
       }
 
     Active.mLocalNodeIds.clear();
 
+    // The remote nodes of a thread may be local nodes of other threads which must be initialized.
+#pragma omp barrier
+
     if (Context.isThread(&Active))
       {
         std::map< size_t, CNode * >::iterator it = Active.mRemoteNodes.begin();
@@ -1288,6 +1531,9 @@ void CNetwork::write(const std::string & file, bool binary)
       json_string_set(pValue, mIsBinary ? "binary" : "text");
     }
 
+  if (mIsBinary)
+    json_object_set_new(mpJson, "sizeofBinaryPID", json_integer(mSizeOfPid));
+
   std::ofstream os(file.c_str());
 
   writePreamble(os);
@@ -1328,6 +1574,8 @@ bool CNetwork::openPartition(const size_t & partition,
       json_string_set(pValue, "binary");
     }
 
+  // Partitions are always binary and use the size of the person ids of the network
+  json_object_set_new(pJson, "sizeofBinaryPID", json_integer(mSizeOfPid));
   json_object_set_new(pJson, "partition", json_object());
 
   pValue = json_object_get(pJson, "partition");
@@ -1336,6 +1584,7 @@ bool CNetwork::openPartition(const size_t & partition,
   json_object_set_new(pValue, "firstLocalNode", json_integer(firstLocalNode));
   json_object_set_new(pValue, "beyondLocalNode", json_integer(beyondLocalNode));
   json_object_set_new(pValue, "numberOfEdges", json_integer(numberOfEdges));
+  json_object_set_new(pValue, "edgePrecision", json_string(sizeof(CEdge::real) == sizeof(float) ? "single" : "double"));
 
   std::ostringstream File;
   File << FileName << "." << partition - 1;
@@ -1418,10 +1667,22 @@ bool CNetwork::haveValidPartition(const int & parts)
 
           valid &= (json_is_integer(pValue) && json_integer_value(pValue) == parts);
 
+          // Partitions with single precision edge attributes are recreated when double precision is used
+          pValue = json_object_get(pPartition, "edgePrecision");
+
+          valid &= (sizeof(CEdge::real) == sizeof(float)
+                    || !json_is_string(pValue)
+                    || strcmp(json_string_value(pValue), "double") == 0);
+
           pValue = json_object_get(pJson, "encoding");
 
           valid &= (json_is_string(pValue) && strcmp(json_string_value(pValue), "binary") == 0);
 
+          // Partitions without the binary size of the person ids were written with 8 byte ids and are recreated
+          pValue = json_object_get(pJson, "sizeofBinaryPID");
+
+          valid &= (json_is_integer(pValue) && (size_t) json_integer_value(pValue) == mSizeOfPid);
+
           json_decref(pJson);
         }
       else
@@ -1489,15 +1750,18 @@ CNode * CNetwork::lookupNode(const size_t & id, const bool localOnly) const
           if (Context.isThread(this))
             return Context.Master().lookupNode(id, false);
 
-          std::map< size_t, CNode * >::const_iterator found = mRemoteNodes.find(id);
-
-          if (found != mRemoteNodes.end())
-            return const_cast< CNode * >(found->second);
+          return mRemoteNodeIndex.find(id);
         }
 
       return NULL;
     }
 
+  // The index of the master covers the local nodes of all threads
+  const CNetwork & Master = Context.Master();
+
+  if (!Master.mLocalNodeIndex.empty())
+    return Master.mLocalNodeIndex[id - Master.mFirstLocalNode];
+
   CNode * pLeft = mLocalNodes;
   CNode * pRight = mLocalNodes + mLocalNodesSize - 1;
   CNode * pCurrent = pLeft + (pRight - pLeft) / 2;
@@ -1523,14 +1787,75 @@ CNode * CNetwork::lookupNode(const size_t & id, const bool localOnly) const
   return NULL;
 }
 
-CEdge * CNetwork::lookupEdge(const size_t & targetId, const size_t & sourceId) const
+// static
+#ifdef USE_LOCATION_ID
+size_t CNetwork::locationId(const CEdge * pEdge)
 {
+  return pEdge->locationId;
+}
+#else
+size_t CNetwork::locationId(const CEdge * /* pEdge */)
+{
+  return 0;
+}
+#endif // USE_LOCATION_ID
+
+// Orders the edges of a target by source, location, and their position
+struct EdgeOrder
+{
+  const CEdge * pEdges;
+
+  EdgeOrder(const CEdge * edges)
+    : pEdges(edges)
+  {}
+
+  bool operator()(const unsigned int & lhs, const unsigned int & rhs) const
+  {
+    const CEdge * pLhs = pEdges + lhs;
+    const CEdge * pRhs = pEdges + rhs;
+
+    if (pLhs->sourceId != pRhs->sourceId)
+      return pLhs->sourceId < pRhs->sourceId;
+
+    if (CNetwork::locationId(pLhs) != CNetwork::locationId(pRhs))
+      return CNetwork::locationId(pLhs) < CNetwork::locationId(pRhs);
+
+    return lhs < rhs;
+  }
 
+  bool operator()(const unsigned int & lhs, const std::pair< size_t, size_t > & rhs) const
+  {
+    const CEdge * pLhs = pEdges + lhs;
+
+    if (pLhs->sourceId != rhs.first)
+      return pLhs->sourceId < rhs.first;
+
+    return CNetwork::locationId(pLhs) < rhs.second;
+  }
+};
+
+void CNetwork::indexEdges(const CNode * pNode)
+{
+  if (pNode->EdgesSize == 0)
+    return;
+
+  unsigned int * pBegin = mEdgeIndex.data() + (pNode->Edges - mEdges);
+  unsigned int * pEnd = pBegin + pNode->EdgesSize;
+  unsigned int Position = 0;
+
+  for (unsigned int * pIt = pBegin; pIt != pEnd; ++pIt, ++Position)
+    *pIt = Position;
+
+  std::sort(pBegin, pEnd, EdgeOrder(pNode->Edges));
+}
+
+CEdge * CNetwork::lookupEdge(const size_t & targetId, const size_t & sourceId, const size_t & locationId, const size_t & occurrence) const
+{
   // We only have edges for local target nodes
   if (targetId < mFirstLocalNode || mBeyondLocalNode <= targetId)
     {
       if (Context.isThread(this))
-        return Context.Master().lookupEdge(targetId, sourceId);
+        return Context.Master().lookupEdge(targetId, sourceId, locationId, occurrence);
       else
         return NULL;
     }
@@ -1538,34 +1863,45 @@ CEdge * CNetwork::lookupEdge(const size_t & targetId, const size_t & sourceId) c
   CNode * pTargetNode = lookupNode(targetId, true);
 
   // Handle invalid requests
-  if (pTargetNode == NULL)
+  if (pTargetNode == NULL
+      || pTargetNode->EdgesSize == 0)
     return NULL;
 
-  // TODO CRITICAL This is broken since the edges are not sorted by source node Id
-  // furthermore the targetNodeId, sourceNodeId is not a unique index
-  CEdge * pLeft = pTargetNode->Edges;
-  CEdge * pRight = pLeft + pTargetNode->EdgesSize;
-  CEdge * pCurrent = pLeft + (pRight - pLeft) / 2;
+  // The edge index is maintained by the master for the partitions of all threads
+  const CNetwork & Master = Context.Master();
+  const unsigned int * pBegin = Master.mEdgeIndex.data() + (pTargetNode->Edges - Master.mEdges);
+  const unsigned int * pEnd = pBegin + pTargetNode->EdgesSize;
+  const unsigned int * pFound = std::lower_bound(pBegin, pEnd, std::make_pair(sourceId, locationId), EdgeOrder(pTargetNode->Edges));
 
-  while (pLeft <= pRight)
-    {
-      if (pCurrent->sourceId < sourceId)
-        {
-          pLeft = pCurrent + 1;
-        }
-      else if (pCurrent->sourceId > sourceId)
-        {
-          pRight = pCurrent - 1;
-        }
-      else
-        {
-          return pCurrent;
-        }
+  if (pEnd - pFound <= (std::ptrdiff_t) occurrence)
+    return NULL;
 
-      pCurrent = pLeft + (pRight - pLeft) / 2;
-    }
+  CEdge * pEdge = pTargetNode->Edges + *(pFound + occurrence);
 
-  return NULL;
+  if (pEdge->sourceId != sourceId
+      || CNetwork::locationId(pEdge) != locationId)
+    return NULL;
+
+  return pEdge;
+}
+
+// static
+size_t CNetwork::occurrence(const CEdge * pEdge)
+{
+  const CEdge * pIt = pEdge->pTarget->Edges;
+  const CEdge * pEnd = pIt + pEdge->pTarget->EdgesSize;
+  size_t Occurrence = 0;
+
+  // Edges are only stored with local targets
+  if (pEdge < pIt || pEnd <= pEdge)
+    return 0;
+
+  for (; pIt != pEdge; ++pIt)
+    if (pIt->sourceId == pEdge->sourceId
+        && locationId(pIt) == locationId(pEdge))
+      ++Occurrence;
+
+  return Occurrence;
 }
 
 bool CNetwork::loadEdge(CEdge * pEdge, std::istream & is) const
@@ -1574,7 +1910,7 @@ bool CNetwork::loadEdge(CEdge * pEdge, std::istream & is) const
 
   if (mIsBinary)
     {
-      pEdge->fromBinary(is);
+      pEdge->fromBinary(is, mBinarySizeOfPid);
 
       success = is.good() && (mFirstLocalNode == 0 || (mFirstLocalNode <= pEdge->targetId && pEdge->targetId < mBeyondLocalNode));
       if (!success)
@@ -1601,67 +1937,26 @@ bool CNetwork::loadEdge(CEdge * pEdge, std::istream & is) const
         }
 
       const char * ptr = Line;
-      int Read;
+      int Read = 0;
 
-      static char targetActivity[128];
-      static char sourceActivity[128];
-      static char edgeTrait[128];
+      // The buffers are local since edges are loaded concurrently by all threads.
+      char targetActivity[128];
+      char sourceActivity[128];
+      double Duration;
 
-      if (5 != sscanf(ptr, "%zu,%[^,],%zu,%[^,],%lf%n", &pEdge->targetId, targetActivity, &pEdge->sourceId, sourceActivity, &pEdge->duration, &Read))
+      if (5 != sscanf(ptr, "%zu,%127[^,],%zu,%127[^,],%lf%n", &pEdge->targetId, targetActivity, &pEdge->sourceId, sourceActivity, &Duration, &Read))
         {
-          success = false;
+          CLogger::error("CEdge: Invalid edge encoding '{}'.", Line);
+          return false;
         }
 
+      pEdge->duration = Duration;
+
       success &= CTrait::ActivityTrait->fromString(targetActivity, pEdge->targetActivity);
       success &= CTrait::ActivityTrait->fromString(sourceActivity, pEdge->sourceActivity);
 
       ptr += Read;
-
-#ifdef USE_LOCATION_ID
-      if (CEdge::HasLocationId)
-        {
-          if (1 != sscanf(ptr, ",%zu%n", &pEdge->locationId, &Read))
-            {
-              success = false;
-            }
-
-          ptr += Read;
-        }
-#endif
-
-      if (CEdge::HasEdgeTrait)
-        {
-          if (1 != sscanf(ptr, ",%[^,]%n", edgeTrait, &Read))
-            {
-              success = false;
-            }
-
-          CTrait::EdgeTrait->fromString(edgeTrait, pEdge->edgeTrait);
-          ptr += Read;
-        }
-
-      if (CEdge::HasActiveField)
-        {
-          char Active;
-
-          if (1 != sscanf(ptr, ",%c%n", &Active, &Read))
-            {
-              success = false;
-            }
-
-          pEdge->active = (Active == '1');
-          ptr += Read;
-        }
-
-      if (CEdge::HasWeightField)
-        {
-          if (1 != sscanf(ptr, ",%lf%n", &pEdge->weight, &Read))
-            {
-              success = false;
-            }
-
-          ptr += Read;
-        }
+      success &= (*ReadColumns)(pEdge, ptr);
 
       if (success)
         success = (*ptr == 0 || *ptr == '\r');
@@ -1677,39 +1972,19 @@ void CNetwork::writeEdge(CEdge * pEdge, std::ostream & os) const
 {
   if (mIsBinary)
     {
-      pEdge->toBinary(os);
+      pEdge->toBinary(os, mSizeOfPid);
     }
   else
     {
-      os << pEdge->targetId;
-      os << "," << CTrait::ActivityTrait->toString(pEdge->targetActivity);
-      os << "," << pEdge->sourceId;
-      os << "," << CTrait::ActivityTrait->toString(pEdge->sourceActivity);
-      os << "," << pEdge->duration;
-
-#ifdef USE_LOCATION_ID
-      if (CEdge::HasLocationId)
-        {
-          os << "," << pEdge->locationId;
-        }
-#endif
-
-      if (CEdge::HasEdgeTrait)
-        {
-          os << "," << CTrait::EdgeTrait->toString(pEdge->edgeTrait);
-        }
-
-      if (CEdge::HasActiveField)
-        {
-          os << "," << pEdge->active;
-        }
-
-      if (CEdge::HasWeightField)
-        {
-          os << "," << pEdge->weight;
-        }
-
-      os << std::endl;
+      // Formatting through the buffer avoids the locale aware stream operators and flushing each line.
+      mWriteBuffer << pEdge->targetId;
+      mWriteBuffer << ',' << CTrait::ActivityTrait->toString(pEdge->targetActivity);
+      mWriteBuffer << ',' << pEdge->sourceId;
+      mWriteBuffer << ',' << CTrait::ActivityTrait->toString(pEdge->sourceActivity);
+      mWriteBuffer << ',' << pEdge->duration;
+      (*WriteColumns)(pEdge, mWriteBuffer);
+      mWriteBuffer << '\n';
+      mWriteBuffer.flush(os);
     }
 }
 
@@ -1720,18 +1995,201 @@ const bool & CNetwork::isValid() const
 
 int CNetwork::broadcastChanges()
 {
+  // Remote nodes owned by processes on the same host are read from shared memory. Messages are only exchanged
+  // with processes on other hosts.
+  if (mSharedRanks.empty())
+    initSharedNodes();
+
+  if (mpSharedNodes != NULL)
+    {
+      ++mSharedSequence;
+      publishSharedNodes();
+    }
+
+  // Every process exchanges at least the message size with every other process. After the exchange all processes
+  // on the host have therefore published their changes.
   CCommunicate::Send SendNodes(&CChanges::sendNodesRequested);
   CCommunicate::ClassMemberReceive< CNetwork > ReceiveNodes(this, &CNetwork::receiveNodes);
   CCommunicate::roundRobin(&SendNodes, &ReceiveNodes);
 
+  if (mpSharedNodes != NULL)
+    updateSharedNodes();
+
   CChanges::reset();
 
   return (int) CCommunicate::ErrorCode::Success;
 }
 
+bool CNetwork::isSharedRank(const int & rank) const
+{
+  return mpSharedNodes != NULL && mSharedRanks[rank];
+}
+
+struct CNetwork::SharedNode
+{
+  size_t id;
+  CModel::state_t healthState;
+  double susceptibilityFactor;
+  double susceptibility;
+  double infectivityFactor;
+  double infectivity;
+  CTraitData::base nodeTrait;
+  // The sequence number of the last broadcast in which the node changed
+  size_t sequence;
+
+  static bool lessId(const SharedNode & node, const size_t & id)
+  {
+    return node.id < id;
+  }
+};
+
+void CNetwork::initSharedNodes()
+{
+  mSharedRanks.assign(CCommunicate::MPIProcesses, false);
+
+#ifdef USE_MPI
+  if (CCommunicate::MPIHostProcesses < 2)
+    return;
+
+  // The shared segment of each process starts with its local node range followed by the state of its nodes.
+  MPI_Aint Size = 3 * sizeof(size_t) + mLocalNodesSize * sizeof(SharedNode);
+  size_t * pSegment = NULL;
+  mSharedWindow = MPI_WIN_NULL;
+
+  int Allocated = (MPI_Win_allocate_shared(Size, 1, MPI_INFO_NULL, CCommunicate::MPIHostCommunicator, &pSegment, &mSharedWindow) == MPI_SUCCESS);
+
+  // All processes on the host must agree before entering any barrier. If the allocation failed on any of them
+  // changes are exchanged through messages.
+  MPI_Allreduce(MPI_IN_PLACE, &Allocated, 1, MPI_INT, MPI_LAND, CCommunicate::MPIHostCommunicator);
+
+  if (!Allocated)
+    {
+      CLogger::warn("CNetwork::initSharedNodes: Allocating shared memory failed ({} bytes), exchanging changes through messages.", Size);
+
+      // All processes of the host reach this point after the Allreduce.
+      if (mSharedWindow != MPI_WIN_NULL)
+        MPI_Win_free(&mSharedWindow);
+
+      return;
+    }
+
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, mSharedWindow);
+
+  pSegment[0] = mFirstLocalNode;
+  pSegment[1] = mBeyondLocalNode;
+  pSegment[2] = mLocalNodesSize;
+  mpSharedNodes = reinterpret_cast< SharedNode * >(pSegment + 3);
+
+  // Remote nodes are only updated once their state has been published as changed.
+  SharedNode * pShared = mpSharedNodes;
+  CNode * pNode = mLocalNodes;
+  CNode * pNodeEnd = mLocalNodes + mLocalNodesSize;
+
+  for (; pNode != pNodeEnd; ++pNode, ++pShared)
+    {
+      pShared->id = pNode->id;
+      pShared->sequence = 0;
+    }
+
+  MPI_Win_sync(mSharedWindow);
+  MPI_Barrier(CCommunicate::MPIHostCommunicator);
+  MPI_Win_sync(mSharedWindow);
+
+  for (int Rank = 0; Rank < CCommunicate::MPIProcesses; ++Rank)
+    {
+      int HostRank = CCommunicate::hostRank(Rank);
+
+      if (Rank == CCommunicate::MPIRank
+          || HostRank < 0)
+        continue;
+
+      MPI_Aint OtherSize;
+      int Unit;
+      size_t * pOther = NULL;
+
+      MPI_Win_shared_query(mSharedWindow, HostRank, &OtherSize, &Unit, &pOther);
+
+      const SharedNode * pBegin = reinterpret_cast< const SharedNode * >(pOther + 3);
+      const SharedNode * pEnd = pBegin + pOther[2];
+
+      std::map< size_t, CNode * >::iterator it = mRemoteNodes.lower_bound(pOther[0]);
+      std::map< size_t, CNode * >::iterator end = mRemoteNodes.lower_bound(pOther[1]);
+
+      for (; it != end; ++it)
+        {
+          const SharedNode * pFound = std::lower_bound(pBegin, pEnd, it->first, SharedNode::lessId);
+
+          if (pFound != pEnd && pFound->id == it->first)
+            mSharedRemoteNodes.emplace_back(it->second, pFound);
+        }
+
+      mSharedRanks[Rank] = true;
+    }
+
+  CLogger::info("CNetwork::initSharedNodes: '{}' remote nodes are shared with '{}' processes on the host.", mSharedRemoteNodes.size(), CCommunicate::MPIHostProcesses - 1);
+
+  MPI_Barrier(CCommunicate::MPIHostCommunicator);
+#endif // USE_MPI
+}
+
+void CNetwork::publishSharedNodes()
+{
+  CNode * pNodeEnd = mLocalNodes + mLocalNodesSize;
+
+  // Only the nodes changed since the last broadcast are published.
+  for (const CChanges::ChangedNodes * pChanged : CChanges::getChangedNodes())
+    for (const CNode * pNode : *pChanged)
+      if (mLocalNodes <= pNode && pNode < pNodeEnd)
+        {
+          SharedNode * pShared = mpSharedNodes + (pNode - mLocalNodes);
+
+          pShared->healthState = pNode->healthState;
+          pShared->susceptibilityFactor = pNode->susceptibilityFactor;
+          pShared->susceptibility = pNode->susceptibility;
+          pShared->infectivityFactor = pNode->infectivityFactor;
+          pShared->infectivity = pNode->infectivity;
+          pShared->nodeTrait = pNode->nodeTrait;
+          pShared->sequence = mSharedSequence;
+        }
+
+#ifdef USE_MPI
+  MPI_Win_sync(mSharedWindow);
+#endif // USE_MPI
+}
+
+void CNetwork::updateSharedNodes()
+{
+#ifdef USE_MPI
+  // The preceding exchange of messages synchronizes the processes.
+  MPI_Win_sync(mSharedWindow);
+
+  size_t Count = 0;
+
+  for (const std::pair< CNode *, const SharedNode * > & Remote : mSharedRemoteNodes)
+    if (Remote.second->sequence == mSharedSequence)
+      {
+        CNode * pNode = Remote.first;
+        const SharedNode * pShared = Remote.second;
+
+        pNode->susceptibilityFactor = pShared->susceptibilityFactor;
+        pNode->susceptibility = pShared->susceptibility;
+        pNode->infectivityFactor = pShared->infectivityFactor;
+        pNode->infectivity = pShared->infectivity;
+        pNode->nodeTrait = pShared->nodeTrait;
+        pNode->setHealthState(CModel::StateFromType(pShared->healthState));
+        ++Count;
+      }
+
+  CLogger::debug("CNetwork::updateSharedNodes: Updated '{}' nodes from shared memory.", Count);
+
+  // No process may publish its next changes before all have read the current ones.
+  MPI_Barrier(CCommunicate::MPIHostCommunicator);
+#endif // USE_MPI
+}
+
 CCommunicate::ErrorCode CNetwork::receiveNodes(std::istream & is, int sender)
 {
-  size_t BufferSize = is.rdbuf()->in_avail() / 56;
+  size_t BufferSize = is.rdbuf()->in_avail() / CNode::BinarySize();
   size_t Count = 0;
 
 #pragma omp parallel for shared(is) reduction(+ \
@@ -1903,6 +2361,9 @@ bool CNetwork::concatenateDump()
       json_string_set(pValue, dumpActiveNetwork.encoding.c_str());
     }
 
+  if (dumpActiveNetwork.encoding == "binary")
+    json_object_set_new(mpJson, "sizeofBinaryPID", json_integer(mSizeOfPid));
+
   pValue = json_object_get(mpJson, "numberOfNodes");
 
   if (json_is_integer(pValue))
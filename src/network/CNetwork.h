@@ -34,6 +34,8 @@
 #include "utilities/CAnnotation.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
+#include "utilities/CFormatBuffer.h"
+#include "utilities/CIdMap.h"
 
 struct json_t;
 class CNode;
@@ -107,7 +109,18 @@ public:
 
   CNode * lookupNode(const size_t & id, const bool localOnly) const;
 
-  CEdge * lookupEdge(const size_t & targetId, const size_t & sourceId) const;
+  // Find an edge by its target, source, and location. Edges with identical values are distinguished by their
+  // occurrence in the network file.
+  CEdge * lookupEdge(const size_t & targetId, const size_t & sourceId, const size_t & locationId, const size_t & occurrence) const;
+
+  // The occurrence of the edge among the edges of its target with the same source and location
+  static size_t occurrence(const CEdge * pEdge);
+
+  static size_t locationId(const CEdge * pEdge);
+
+  // The parsing and formatting of the optional edge columns, which are specialized for the edge schema
+  typedef bool (*ReadEdgeColumns)(CEdge * pEdge, const char *& ptr);
+  typedef void (*WriteEdgeColumns)(const CEdge * pEdge, CFormatBuffer & buffer);
 
   CNode * beginNode();
 
@@ -129,6 +142,9 @@ public:
 
   int broadcastChanges();
 
+  // Check whether the remote nodes owned by the rank are updated through memory shared on the host
+  bool isSharedRank(const int & rank) const;
+
   CCommunicate::ErrorCode receiveNodes(std::istream & is, int sender);
 
   const size_t & getLocalNodeCount() const;
@@ -147,8 +163,21 @@ public:
   const std::array< size_t, 2 > & getTotalNodeRange() const;
 
 private:
+  // The state of a local node as published to the processes on the same host
+  struct SharedNode;
+
   void initNodes();
   void initOutgoingEdges();
+  void indexEdges(const CNode * pNode);
+
+  // Select the specialization of the edge column I/O once the edge schema is known
+  static void selectEdgeSchema();
+
+  static ReadEdgeColumns ReadColumns;
+  static WriteEdgeColumns WriteColumns;
+  void initSharedNodes();
+  void publishSharedNodes();
+  void updateSharedNodes();
   
   std::string mFile;
   CNode * mLocalNodes;
@@ -158,6 +187,10 @@ private:
   std::vector< size_t > mLocalNodeIds;
   std::map< CNode *, std::vector< CEdge * > > mOutgoingEdges;
   std::map< size_t, CNode *> mRemoteNodes;
+  CIdMap< CNode > mRemoteNodeIndex;
+  std::vector< CNode * > mLocalNodeIndex;
+  // The edges of each target sorted by source, location, and occurrence
+  std::vector< unsigned int > mEdgeIndex;
   std::set< size_t > mSourceOnlyNodes;
   CNode * mNodes;
   size_t mNodesSize;
@@ -166,12 +199,19 @@ private:
   size_t mTotalNodesSize;
   size_t mTotalEdgesSize;
   std::array< size_t, 2 > mTotalNodeRange;
+  MPI_Win mSharedWindow;
+  SharedNode * mpSharedNodes;
+  size_t mSharedSequence;
+  std::vector< bool > mSharedRanks;
+  std::vector< std::pair< CNode *, const SharedNode * > > mSharedRemoteNodes;
   size_t mSizeOfPid;
+  size_t mBinarySizeOfPid;
   std::string mAccumulationTime;
   double mTimeResolution;
   bool mIsBinary;
   bool mValid;
   json_t * mpJson;
+  mutable CFormatBuffer mWriteBuffer;
 
   dump_active_network mDumpActiveNetwork;
 
@@ -22,6 +22,8 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <cstdint>
+
 #include "network/CNode.h"
 #include "network/CEdge.h"
 #include "network/CNetwork.h"
@@ -147,9 +149,41 @@ CNode & CNode::operator = (const CNode & rhs)
   return *this;
 }
 
+// static
+void CNode::writePid(std::ostream & os, const size_t & id)
+{
+  if (SizeOfPid == sizeof(uint32_t))
+    {
+      uint32_t Id = id;
+      os.write(reinterpret_cast< const char * >(&Id), sizeof(uint32_t));
+    }
+  else
+    os.write(reinterpret_cast< const char * >(&id), sizeof(size_t));
+}
+
+// static
+void CNode::readPid(std::istream & is, size_t & id)
+{
+  if (SizeOfPid == sizeof(uint32_t))
+    {
+      uint32_t Id = 0;
+      is.read(reinterpret_cast< char * >(&Id), sizeof(uint32_t));
+      id = Id;
+    }
+  else
+    is.read(reinterpret_cast< char * >(&id), sizeof(size_t));
+}
+
+// static
+size_t CNode::BinarySize()
+{
+  return SizeOfPid + 44;
+}
+
 void CNode::toBinary(std::ostream & os) const
 {
-  os.write(reinterpret_cast<const char *>(&id), 56);
+  writePid(os, id);
+  os.write(reinterpret_cast<const char *>(&healthState), 44);
 
   /*
   os.write(reinterpret_cast<const char *>(&id), sizeof(size_t));
@@ -164,12 +198,13 @@ void CNode::toBinary(std::ostream & os) const
 
 void CNode::fromBinary(std::istream & is)
 {
-  is.read(reinterpret_cast<char *>(&id), 56);
+  readPid(is, id);
+  is.read(reinterpret_cast<char *>(&healthState), 44);
 
   size_t read = is.gcount(); 
   
   if (read != 0
-      && read != 56)
+      && read != 44)
     {
       CLogger::error("CNode: fromBinary read '{}'.", read); 
     }
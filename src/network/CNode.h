@@ -56,6 +56,15 @@ public:
 
   static CNode getDefault();
 
+  // The size of the person Id (PID) in binary records and messages, i.e., 4 or 8 bytes
+  static size_t SizeOfPid;
+
+  static void writePid(std::ostream & os, const size_t & id);
+  static void readPid(std::istream & is, size_t & id);
+
+  // The size of a node's binary data
+  static size_t BinarySize();
+
   CNode();
   CNode(const CNode & src);
 
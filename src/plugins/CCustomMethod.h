@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "utilities/CLogger.h"
 
 class CEdge;
@@ -35,10 +37,30 @@ class CProgression;
 
 namespace CCustomMethodType 
 {
+  // The version of the plugin interface. Version 1 provides the per element methods and version 2 adds the batch methods.
+  static const unsigned int ABIVersion = 2;
+
   typedef double (*transmission_propensity)(const CTransmission * pTransmission, const CEdge * pEdge);
   typedef const CProgression * (*state_progression)(const CHealthState * pHealthState, const CNode * pNode);
   typedef unsigned int (*progression_dwell_time)(const CProgression * pProgression, const CNode * pNode);
   typedef bool (*increment_tick)(int tick, bool init);
+
+  // The incoming edges of a target node together with the gathered properties of each edge. Edges which cannot
+  // transmit (inactive, not infectious, or no possible transmission) have a NULL transmission and their propensity is ignored.
+  struct transmission_batch
+  {
+    const CNode * pTarget;
+    const CEdge * pEdges;
+    size_t size;
+    const CTransmission * const * pTransmissions;
+    const double * pInfectivities;
+    const double * pDurations;
+    const double * pWeights;
+    double * pPropensities;
+  };
+
+  typedef void (*transmission_propensities)(const transmission_batch & batch);
+  typedef void (*state_progressions)(const CHealthState * pHealthState, const CNode * const * pNodes, size_t size, const CProgression ** pProgressions);
 } // namespace CCustomMethodType
 
 template < class custom_type >
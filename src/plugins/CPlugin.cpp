@@ -25,6 +25,7 @@
 #include <stdio.h>
 
 #include "plugins/CPlugin.h"
+#include "plugins/CCustomMethod.h"
 #include "utilities/CSimConfig.h"
 
 // static
@@ -65,6 +66,17 @@ void CPlugin::Init()
             }
 
           char * error;
+          EpiHiperPluginABIVersion pVersion = (EpiHiperPluginABIVersion) dlsym(pLibraryHandle, "EpiHiperPluginABIVersion");
+
+          // Plugins without a version only use the per element methods of version 1.
+          if ((error = dlerror()) == nullptr
+              && pVersion != nullptr
+              && (*pVersion)() > CCustomMethodType::ABIVersion)
+            {
+              CLogger::error("CPlugin {}: Plugin requires interface version {} (supported: {}).", Plugin, (*pVersion)(), CCustomMethodType::ABIVersion);
+              continue;
+            }
+
           EpiHiperPluginInit pInit = (EpiHiperPluginInit) dlsym(pLibraryHandle, "EpiHiperPluginInit");
 
           if ((error = dlerror()) != nullptr)
@@ -38,6 +38,8 @@ private:
 
 public:
   typedef void (*EpiHiperPluginInit)();
+  // Optional: plugins using the batch methods report the interface version they were compiled against.
+  typedef unsigned int (*EpiHiperPluginABIVersion)();
 
   static void Init();
   static void clear();
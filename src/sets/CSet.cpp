@@ -170,4 +170,23 @@ std::string CSet::getComputableId() const
     os << "CSet: " << mId << " (" << mComputableId  << ") => ()";
 
   return os.str();
-}
\ No newline at end of file
+}
+
+// virtual
+void CSet::registerDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  // The content of the set reports all changes
+  if (mValid && mpSetContent != NULL)
+    mpSetContent->registerDependentCollector(pCollector);
+  else
+    CSetContent::registerDependentCollector(pCollector);
+}
+
+// virtual
+void CSet::deregisterDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  if (mValid && mpSetContent != NULL)
+    mpSetContent->deregisterDependentCollector(pCollector);
+
+  CSetContent::deregisterDependentCollector(pCollector);
+}
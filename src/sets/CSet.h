@@ -68,6 +68,10 @@ public:
     return CSetContent::getContext();
   }
 
+  virtual void registerDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector) override;
+
+  virtual void deregisterDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector) override;
+
 protected:
   virtual bool computeSetContent() override;
 
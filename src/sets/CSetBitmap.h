@@ -0,0 +1,269 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_SETS_CSETBITMAP_H_
+#define SRC_SETS_CSETBITMAP_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Dense representation of a sorted set of elements stored in the contiguous
+ * array [begin, end), i.e., the local nodes or edges of a partition. Each element
+ * is represented by a bit which allows set operations to be performed on 64 elements
+ * at once. Elements outside of the array, e.g., remote nodes in sets with global
+ * scope, are kept in a sorted vector.
+ */
+template < class element_type > class CSetBitmap
+{
+public:
+  typedef std::vector< element_type * > sorted_vector;
+  typedef std::vector< const sorted_vector * > operands;
+
+  /**
+   * A bitmap is used if the density of the elements within the range is at least 1/64,
+   * i.e., on average each word of the bitmap represents at least one element.
+   */
+  static bool isDense(const size_t & size, const element_type * pBegin, const element_type * pEnd);
+
+  /**
+   * Compute the union of the sorted operands choosing the representation based on density.
+   */
+  static void unite(const operands & sets, element_type * pBegin, element_type * pEnd, sorted_vector & result);
+
+  /**
+   * Compute the intersection of the sorted operands choosing the representation based on density.
+   */
+  static void intersect(const operands & sets, element_type * pBegin, element_type * pEnd, sorted_vector & result);
+
+  CSetBitmap(element_type * pBegin, element_type * pEnd);
+
+  void assign(const sorted_vector & set);
+
+  void unite(const sorted_vector & set);
+
+  void intersect(const sorted_vector & set);
+
+  void toSortedVector(sorted_vector & set) const;
+
+private:
+  void split(const sorted_vector & set, std::vector< uint64_t > & words, sorted_vector & outside) const;
+
+  element_type * mpBegin;
+  element_type * mpEnd;
+  std::vector< uint64_t > mWords;
+  sorted_vector mOutside;
+};
+
+// static
+template < class element_type >
+bool CSetBitmap< element_type >::isDense(const size_t & size, const element_type * pBegin, const element_type * pEnd)
+{
+  return pBegin < pEnd
+         && 64 * size >= (size_t) (pEnd - pBegin);
+}
+
+// static
+template < class element_type >
+void CSetBitmap< element_type >::unite(const operands & sets, element_type * pBegin, element_type * pEnd, sorted_vector & result)
+{
+  result.clear();
+
+  if (sets.empty())
+    return;
+
+  size_t Size = 0;
+  typename operands::const_iterator it = sets.begin();
+  typename operands::const_iterator end = sets.end();
+
+  for (; it != end; ++it)
+    Size += (*it)->size();
+
+  if (isDense(Size, pBegin, pEnd))
+    {
+      CSetBitmap Bitmap(pBegin, pEnd);
+
+      for (it = sets.begin(); it != end; ++it)
+        Bitmap.unite(**it);
+
+      Bitmap.toSortedVector(result);
+
+      return;
+    }
+
+  sorted_vector Tmp;
+  result = *sets.front();
+
+  for (it = sets.begin() + 1; it != end; ++it)
+    {
+      Tmp.clear();
+      std::set_union(result.begin(), result.end(), (*it)->begin(), (*it)->end(), std::back_inserter(Tmp));
+      result.swap(Tmp);
+    }
+}
+
+// static
+template < class element_type >
+void CSetBitmap< element_type >::intersect(const operands & sets, element_type * pBegin, element_type * pEnd, sorted_vector & result)
+{
+  result.clear();
+
+  if (sets.empty())
+    return;
+
+  // The result can not be larger than the smallest operand which we therefore process first.
+  operands Sorted(sets);
+  std::sort(Sorted.begin(), Sorted.end(), [](const sorted_vector * pLhs, const sorted_vector * pRhs) {
+    return pLhs->size() < pRhs->size();
+  });
+
+  typename operands::const_iterator it = Sorted.begin();
+  typename operands::const_iterator end = Sorted.end();
+
+  if (isDense(Sorted.front()->size(), pBegin, pEnd))
+    {
+      CSetBitmap Bitmap(pBegin, pEnd);
+      Bitmap.assign(**it);
+
+      for (++it; it != end; ++it)
+        Bitmap.intersect(**it);
+
+      Bitmap.toSortedVector(result);
+
+      return;
+    }
+
+  sorted_vector Tmp;
+  result = **it;
+
+  for (++it; it != end && !result.empty(); ++it)
+    {
+      Tmp.clear();
+      std::set_intersection(result.begin(), result.end(), (*it)->begin(), (*it)->end(), std::back_inserter(Tmp));
+      result.swap(Tmp);
+    }
+}
+
+template < class element_type >
+CSetBitmap< element_type >::CSetBitmap(element_type * pBegin, element_type * pEnd)
+  : mpBegin(pBegin)
+  , mpEnd(pEnd)
+  , mWords((pEnd - pBegin + 63) / 64, 0)
+  , mOutside()
+{}
+
+template < class element_type >
+void CSetBitmap< element_type >::split(const sorted_vector & set, std::vector< uint64_t > & words, sorted_vector & outside) const
+{
+  typename sorted_vector::const_iterator it = set.begin();
+  typename sorted_vector::const_iterator end = set.end();
+
+  for (; it != end; ++it)
+    if (mpBegin <= *it && *it < mpEnd)
+      {
+        size_t Index = *it - mpBegin;
+        words[Index >> 6] |= uint64_t(1) << (Index & 63);
+      }
+    else
+      outside.push_back(*it);
+}
+
+template < class element_type >
+void CSetBitmap< element_type >::assign(const sorted_vector & set)
+{
+  std::fill(mWords.begin(), mWords.end(), 0);
+  mOutside.clear();
+
+  split(set, mWords, mOutside);
+}
+
+template < class element_type >
+void CSetBitmap< element_type >::unite(const sorted_vector & set)
+{
+  sorted_vector Outside;
+  split(set, mWords, Outside);
+
+  if (!Outside.empty())
+    {
+      sorted_vector Tmp;
+      std::set_union(mOutside.begin(), mOutside.end(), Outside.begin(), Outside.end(), std::back_inserter(Tmp));
+      mOutside.swap(Tmp);
+    }
+}
+
+template < class element_type >
+void CSetBitmap< element_type >::intersect(const sorted_vector & set)
+{
+  std::vector< uint64_t > Words(mWords.size(), 0);
+  sorted_vector Outside;
+  split(set, Words, Outside);
+
+  uint64_t * pWord = mWords.data();
+  uint64_t * pWordEnd = pWord + mWords.size();
+  const uint64_t * pOther = Words.data();
+
+  // Word parallel intersection which the compiler is able to vectorize
+  for (; pWord != pWordEnd; ++pWord, ++pOther)
+    *pWord &= *pOther;
+
+  if (!mOutside.empty())
+    {
+      sorted_vector Tmp;
+      std::set_intersection(mOutside.begin(), mOutside.end(), Outside.begin(), Outside.end(), std::back_inserter(Tmp));
+      mOutside.swap(Tmp);
+    }
+}
+
+template < class element_type >
+void CSetBitmap< element_type >::toSortedVector(sorted_vector & set) const
+{
+  set.clear();
+
+  typename sorted_vector::const_iterator itOutside = mOutside.begin();
+  typename sorted_vector::const_iterator endOutside = mOutside.end();
+
+  for (; itOutside != endOutside && *itOutside < mpBegin; ++itOutside)
+    set.push_back(*itOutside);
+
+  const uint64_t * pWord = mWords.data();
+  const uint64_t * pWordEnd = pWord + mWords.size();
+  size_t Offset = 0;
+
+  for (; pWord != pWordEnd; ++pWord, Offset += 64)
+    {
+      uint64_t Word = *pWord;
+
+      while (Word != 0)
+        {
+          set.push_back(mpBegin + Offset + __builtin_ctzll(Word));
+          Word &= Word - 1;
+        }
+    }
+
+  for (; itOutside != endOutside; ++itOutside)
+    set.push_back(*itOutside);
+}
+
+#endif /* SRC_SETS_CSETBITMAP_H_ */
@@ -32,6 +32,7 @@
 
 #include "sets/CNodeElementSelector.h"
 #include "sets/CEdgeElementSelector.h"
+#include "sets/CSetOperation.h"
 #include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "network/CEdge.h"
@@ -270,6 +271,10 @@ inline bool CSetCollector< element_type, selector >::apply()
     Set = temp;
 
   mpSelector->activeContent().sync();
+
+  // Sets derived from the selector re-evaluate the membership of the changed elements
+  mpSelector->recordChanges(Erase);
+  mpSelector->recordChanges(Insert);
   
   CLogger::debug("CSetCollector::apply: returned '{}' elements.",Set.size());
 
@@ -348,4 +353,88 @@ inline CEdge * CSetCollector< CEdge, CEdgeElementSelector >::offset() const
   return CNetwork::Context.Active().beginEdge();
 }
 
+template <> 
+inline std::vector< CNode * > & CSetCollector< CNode, CSetOperation >::getSet() const
+{
+  return mpSelector->activeContent().mNodes;
+}
+
+template <> 
+inline std::vector< CEdge * > & CSetCollector< CEdge, CSetOperation >::getSet() const
+{
+  return mpSelector->activeContent().edges;
+}
+
+template <> 
+inline CNode * CSetCollector< CNode, CSetOperation >::offset() const 
+{
+  return CNetwork::Context.Active().beginNode();
+}
+
+template <> 
+inline CEdge * CSetCollector< CEdge, CSetOperation >::offset() const
+{
+  return CNetwork::Context.Active().beginEdge();
+}
+
+/**
+ * A set operation may contain nodes and edges, i.e., its collector combines a 
+ * node and an edge collector. The changes are recorded by the operands of the 
+ * operation and membership is re-evaluated against all operands.
+ */
+class CSetOperationCollector : public CSetCollectorInterface
+{
+public:
+  CSetOperationCollector(CSetOperation * pOperation)
+    : mNodes(pOperation)
+    , mEdges(pOperation)
+  {}
+
+  virtual ~CSetOperationCollector() {};
+
+  virtual bool isEnabled() const override
+  {
+    return mNodes.isEnabled();
+  }
+
+  virtual std::string getComputableId() const override
+  {
+    return mNodes.getComputableId();
+  }
+
+  virtual bool record(CNode * pNode) override
+  {
+    return mNodes.record(pNode);
+  }
+
+  virtual bool record(CEdge * pEdge) override
+  {
+    return mEdges.record(pEdge);
+  }
+
+  virtual bool apply() override
+  {
+    bool success = mEdges.apply();
+    success &= mNodes.apply();
+
+    return success;
+  }
+
+  virtual void enable() override
+  {
+    mNodes.enable();
+    mEdges.enable();
+  }
+
+  virtual void disable() override
+  {
+    mNodes.disable();
+    mEdges.disable();
+  }
+
+private:
+  CSetCollector< CNode, CSetOperation > mNodes;
+  CSetCollector< CEdge, CSetOperation > mEdges;
+};
+
 #endif // SRC_SET_CSETCOLLECOTR_H_
\ No newline at end of file
@@ -23,6 +23,7 @@
 // END: Copyright 
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <jansson.h>
 
@@ -66,6 +67,7 @@ CSetContent::CSetContent(const Type & type)
   , mJSON()
   , mScope(CSetContent::Scope::local)
   , mpCollector(NULL)
+  , mDependentCollectors()
 {
   mContext.init();
   mValid = true;
@@ -78,6 +80,7 @@ CSetContent::CSetContent(const CSetContent & src)
   , mJSON(src.mJSON)
   , mScope(src.mScope)
   , mpCollector(src.mpCollector)
+  , mDependentCollectors(src.mDependentCollectors)
 {}
 
 CSetContent::~CSetContent()
@@ -91,6 +94,7 @@ bool CSetContent::computeProtected()
       || !mpCollector->isEnabled())
     {     
       mContext.Active().clear();
+      disableDependentCollectors();
       CLogger::debug("CSetContent::computeProtected: '{}' clearing set content.", getComputableId());
     }
 
@@ -312,6 +316,107 @@ const CSetContent::NodeContent & CSetContent::getNodeContent(const CSetContent::
   return activeContent().globalNodes;
 }
 
+// The counter based random stream of an edge is determined by its target, source, location, and occurrence,
+// i.e., parallel edges between the same nodes have distinct streams.
+static size_t edgeEntity(const CEdge * pEdge)
+{
+  size_t Entity = (pEdge->targetId * 0x9E3779B97F4A7C15) ^ pEdge->sourceId;
+
+  Entity = (Entity * 0x9E3779B97F4A7C15) ^ CNetwork::locationId(pEdge);
+
+  return (Entity * 0x9E3779B97F4A7C15) ^ CNetwork::occurrence(pEdge);
+}
+
+// Bernoulli sampling of the elements with the given probability. The number of elements skipped before the next
+// sampled one is geometrically distributed, i.e., one random number is drawn per sampled element.
+template < class Element >
+static void sampleBernoulli(typename std::vector< Element * >::const_iterator it,
+                            typename std::vector< Element * >::const_iterator end,
+                            const double & probability,
+                            std::vector< Element * > & sampled,
+                            std::vector< Element * > & notSampled)
+{
+  if (probability >= 1.0)
+    {
+      sampled.insert(sampled.end(), it, end);
+      return;
+    }
+
+  if (probability <= 0.0)
+    {
+      notSampled.insert(notSampled.end(), it, end);
+      return;
+    }
+
+  CRandom::uniform_real Uniform(0.0, 1.0);
+  CRandom::generator_t & Generator = CRandom::G.Active();
+  double LogComplement = std::log1p(-probability);
+
+  while (it != end)
+    {
+      // P(Skip >= k) = (1 - probability)^k
+      double Skip = std::floor(std::log(1.0 - Uniform(Generator)) / LogComplement);
+
+      if (Skip >= end - it)
+        break;
+
+      notSampled.insert(notSampled.end(), it, it + (size_t) Skip);
+      it += (size_t) Skip;
+
+      sampled.push_back(*it);
+      ++it;
+    }
+
+  notSampled.insert(notSampled.end(), it, end);
+}
+
+// Sequential sampling of min(max, size) elements (Vitter's method A). The number of elements skipped before the
+// next sampled one is determined by a single random number, i.e., one is drawn per sampled element.
+template < class Element >
+static void sampleSequential(typename std::vector< Element * >::const_iterator it,
+                             typename std::vector< Element * >::const_iterator end,
+                             const size_t & max,
+                             std::vector< Element * > & sampled,
+                             std::vector< Element * > & notSampled)
+{
+  CRandom::uniform_real Uniform(0.0, 1.0);
+  CRandom::generator_t & Generator = CRandom::G.Active();
+
+  size_t Available = end - it;
+  size_t Requested = std::min(max, Available);
+
+  for (; Requested > 0; --Requested)
+    {
+      size_t Skip = 0;
+
+      if (Requested < Available)
+        {
+          double V = Uniform(Generator);
+          double Top = Available - Requested;
+          double Total = Available;
+          double Quotient = Top / Total;
+
+          while (Quotient > V)
+            {
+              ++Skip;
+              Top -= 1.0;
+              Total -= 1.0;
+              Quotient *= Top / Total;
+            }
+        }
+
+      notSampled.insert(notSampled.end(), it, it + Skip);
+      it += Skip;
+
+      sampled.push_back(*it);
+      ++it;
+
+      Available -= Skip + 1;
+    }
+
+  notSampled.insert(notSampled.end(), it, end);
+}
+
 void CSetContent::sampleMax(const size_t & max, CSetContent & sampled, CSetContent & notSampled) const
 {
   SetContent & Sampled = sampled.activeContent();
@@ -327,8 +432,21 @@ void CSetContent::sampleMax(const size_t & max, CSetContent & sampled, CSetConte
   CRandom::generator_t & Generator = CRandom::G.Active();
   const SetContent & Active = activeContent();
 
+  // Counter based draws are made per element so that the sample does not depend on the decomposition.
+  if (!CRandom::CounterBased)
+    {
+      if (size() == Active.mNodes.size())
+        {
+          const NodeContent & Nodes = getNodeContent(Scope::local);
+          sampleSequential(Nodes.begin(), Nodes.end(), max, Sampled.mNodes, NotSampled.mNodes);
+        }
+      else if (size() == Active.edges.size())
+        {
+          sampleSequential(Active.edges.begin(), Active.edges.end(), max, Sampled.edges, NotSampled.edges);
+        }
+    }
   // Sampling is only supported if we have either only nodes or only edges;
-  if (size() == Active.mNodes.size())
+  else if (size() == Active.mNodes.size())
     {
       const NodeContent & Nodes = getNodeContent(Scope::local);
 
@@ -340,6 +458,8 @@ void CSetContent::sampleMax(const size_t & max, CSetContent & sampled, CSetConte
 
       for (; it != end; ++it)
         {
+          Generator.setStream((*it)->id, CRandom::Stream::sampling, sampled.mComputableId);
+
           if (Available <= Requested
               || (Requested > 0.5
                   && Probability(Generator) < Requested / Available))
@@ -365,6 +485,8 @@ void CSetContent::sampleMax(const size_t & max, CSetContent & sampled, CSetConte
 
       for (; it != end; ++it)
         {
+          Generator.setStream(edgeEntity(*it), CRandom::Stream::sampling, sampled.mComputableId);
+
           if (Available <= Requested
               || (Requested > 0.5
                   && Probability(Generator) < Requested / Available))
@@ -398,8 +520,21 @@ void CSetContent::samplePercent(const double & percent, CSetContent & sampled, C
   CRandom::generator_t & Generator = CRandom::G.Active();
   const SetContent & Active = activeContent();
 
+  // Counter based draws are made per element so that the sample does not depend on the decomposition.
+  if (!CRandom::CounterBased)
+    {
+      if (size() == Active.mNodes.size())
+        {
+          const NodeContent & Nodes = getNodeContent(Scope::local);
+          sampleBernoulli(Nodes.begin(), Nodes.end(), percent / 100.0, Sampled.mNodes, NotSampled.mNodes);
+        }
+      else if (size() == Active.edges.size())
+        {
+          sampleBernoulli(Active.edges.begin(), Active.edges.end(), percent / 100.0, Sampled.edges, NotSampled.edges);
+        }
+    }
   // Sampling is only supported if we have either only nodes or only edges;
-  if (size() == Active.mNodes.size())
+  else if (size() == Active.mNodes.size())
     {
       const NodeContent & Nodes = getNodeContent(Scope::local);
 
@@ -407,10 +542,14 @@ void CSetContent::samplePercent(const double & percent, CSetContent & sampled, C
       std::vector< CNode * >::const_iterator end = Nodes.end();
 
       for (; it != end; ++it)
-        if (Percent(Generator) < percent)
-          Sampled.mNodes.push_back(*it);
-        else
-          NotSampled.mNodes.push_back(*it);
+        {
+          Generator.setStream((*it)->id, CRandom::Stream::sampling, sampled.mComputableId);
+
+          if (Percent(Generator) < percent)
+            Sampled.mNodes.push_back(*it);
+          else
+            NotSampled.mNodes.push_back(*it);
+        }
     }
   else if (size() == Active.edges.size())
     {
@@ -418,10 +557,14 @@ void CSetContent::samplePercent(const double & percent, CSetContent & sampled, C
       std::vector< CEdge * >::const_iterator end = Active.edges.end();
 
       for (; it != end; ++it)
-        if (Percent(Generator) < percent)
-          Sampled.edges.push_back(*it);
-        else
-          NotSampled.edges.push_back(*it);
+        {
+          Generator.setStream(edgeEntity(*it), CRandom::Stream::sampling, sampled.mComputableId);
+
+          if (Percent(Generator) < percent)
+            Sampled.edges.push_back(*it);
+          else
+            NotSampled.edges.push_back(*it);
+        }
     }
 
   Sampled.sync();
@@ -489,3 +632,44 @@ bool CSetContent::collectorEnabled() const
   return false;
 }
 
+// virtual
+void CSetContent::registerDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  if (pCollector)
+    mDependentCollectors.insert(pCollector);
+}
+
+// virtual
+void CSetContent::deregisterDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  mDependentCollectors.erase(pCollector);
+}
+
+void CSetContent::recordChanges(const std::vector< CNode * > & changed) const
+{
+  if (changed.empty())
+    return;
+
+  for (const std::shared_ptr< CSetCollectorInterface > & pCollector : mDependentCollectors)
+    if (pCollector->isEnabled())
+      for (CNode * pNode : changed)
+        pCollector->record(pNode);
+}
+
+void CSetContent::recordChanges(const std::vector< CEdge * > & changed) const
+{
+  if (changed.empty())
+    return;
+
+  for (const std::shared_ptr< CSetCollectorInterface > & pCollector : mDependentCollectors)
+    if (pCollector->isEnabled())
+      for (CEdge * pEdge : changed)
+        pCollector->record(pEdge);
+}
+
+void CSetContent::disableDependentCollectors() const
+{
+  for (const std::shared_ptr< CSetCollectorInterface > & pCollector : mDependentCollectors)
+    pCollector->disable();
+}
+
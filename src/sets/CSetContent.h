@@ -138,6 +138,11 @@ public:
 
     void addMatching(element_type * pType);
 
+    bool matches(const element_type * pType) const;
+
+    // Append elements matched by any thread which must be sorted and follow the current content
+    void append(const std::vector< element_type * > & matching);
+
     void start();
 
     void finish();
@@ -215,7 +220,25 @@ public:
 
   bool collectorEnabled() const;
 
+  /**
+   * Register the collector of a set derived from this set, e.g., an operation.
+   * The collector is notified about each element added to or removed from the
+   * content when it is updated incrementally and disabled whenever the content
+   * is fully recomputed.
+   * @param std::shared_ptr< CSetCollectorInterface > pCollector
+   */
+  virtual void registerDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector);
+
+  virtual void deregisterDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector);
+
+  void recordChanges(const std::vector< CNode * > & changed) const;
+
+  void recordChanges(const std::vector< CEdge * > & changed) const;
+
 protected:
+  void disableDependentCollectors() const;
+
+
   virtual bool computeProtected() override;
 
   virtual bool computeSetContent() = 0;
@@ -239,6 +262,8 @@ protected:
   Scope mScope;
 
   std::shared_ptr< CSetCollectorInterface > mpCollector;
+
+  std::set< std::shared_ptr< CSetCollectorInterface > > mDependentCollectors;
 };
 
 template < class element_type >
@@ -278,16 +303,30 @@ void CSetContent::Filter< element_type >::addMatching(element_type * pType)
     mpSet->push_back(pType);
 }
 
+template < class element_type >
+bool CSetContent::Filter< element_type >::matches(const element_type * pType) const
+{
+  return mpSetContent->filter(pType);
+}
+
+template < class element_type >
+void CSetContent::Filter< element_type >::append(const std::vector< element_type * > & matching)
+{
+  mpSet->insert(mpSet->end(), matching.begin(), matching.end());
+}
+
 template < class element_type >
 void CSetContent::Filter< element_type >::start() 
 {
   mpSetContent->activeContent().clear();
+  mpSetContent->disableDependentCollectors();
 }
 
 template < class element_type >
 void CSetContent::Filter< element_type >::finish() 
 {
   mpSetContent->activeContent().sync();
+  mpSetContent->mComputedOnce.Active() = true;
   CLogger::debug("CSetContent: '{}' contains '{}' elements.", mpSetContent->getComputableId(), mpSet->size());
 }
 
@@ -28,9 +28,13 @@
 #include <jansson.h>
 
 #include "sets/CSetOperation.h"
+#include "sets/CSetBitmap.h"
+#include "sets/CSetCollector.h"
 #include "utilities/CLogger.h"
 #include "utilities/CSimConfig.h"
 #include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "network/CEdge.h"
 
 CSetOperation::CSetOperation()
   : CSetContent(CSetContent::Type::operation)
@@ -145,16 +149,89 @@ bool CSetOperation::lessThanProtected(const CSetContent & rhs) const
 // virtual
 bool CSetOperation::computeSetContent()
 {
-  if (mValid
-      && mpCompute != NULL)
-    return (this->*mpCompute)();
+  if (mValid)
+    {
+      if (mComputedOnce.Active()
+           && mpCollector 
+           && mpCollector->isEnabled())
+        return mpCollector->apply();
+      else if (mpCompute != NULL)
+        {
+          if (mpCollector)
+            mpCollector->enable();
+
+          return (this->*mpCompute)();
+        }
+    }
 
   return false;
 }
 
+// virtual
+void CSetOperation::determineIsStatic()
+{
+  CComputable::determineIsStatic();
+
+  // Non static local operations are updated incrementally from the changes reported by their operands.
+  if (mValid
+      && !mStatic
+      && mScope == Scope::local
+      && !mpCollector)
+    {
+      mpCollector = std::shared_ptr< CSetCollectorInterface >(new CSetOperationCollector(this));
+
+      std::set< CSetContent * >::const_iterator it = mSets.begin();
+      std::set< CSetContent * >::const_iterator end = mSets.end();
+
+      for (; it != end; ++it)
+        (*it)->registerDependentCollector(mpCollector);
+    }
+}
+
+// virtual
+bool CSetOperation::filter(const CNode * pNode) const
+{
+  bool Union = (mpCompute == &CSetOperation::computeUnion);
+
+  std::set< CSetContent * >::const_iterator it = mSets.begin();
+  std::set< CSetContent * >::const_iterator end = mSets.end();
+
+  for (; it != end; ++it)
+    if ((*it)->contains(const_cast< CNode * >(pNode)) == Union)
+      return Union;
+
+  return !Union;
+}
+
+// virtual
+bool CSetOperation::filter(const CEdge * pEdge) const
+{
+  bool Union = (mpCompute == &CSetOperation::computeUnion);
+
+  std::set< CSetContent * >::const_iterator it = mSets.begin();
+  std::set< CSetContent * >::const_iterator end = mSets.end();
+
+  for (; it != end; ++it)
+    if ((*it)->contains(const_cast< CEdge * >(pEdge)) == Union)
+      return Union;
+
+  return !Union;
+}
+
 // virtual
 void CSetOperation::setScopeProtected()
 {
+  if (mpCollector)
+    {
+      std::set< CSetContent * >::const_iterator it = mSets.begin();
+      std::set< CSetContent * >::const_iterator end = mSets.end();
+
+      for (; it != end; ++it)
+        (*it)->deregisterDependentCollector(mpCollector);
+
+      mpCollector.reset();
+    }
+
   std::set< CSetContent * >::const_iterator it = mSets.begin();
   std::set< CSetContent * >::const_iterator end = mSets.end();
 
@@ -166,46 +243,32 @@ bool CSetOperation::computeUnion()
 {
   SetContent & Active = activeContent();
   CDBFieldValues & DBFieldValues = Active.dBFieldValues;
+  DBFieldValues.clear();
 
-  SetContent C1, C2, *pIn, *pOut;
-  pIn = &C1;
-  pOut = &C2;
-
-  bool first = true;
+  CSetBitmap< CNode >::operands Nodes;
+  CSetBitmap< CEdge >::operands Edges;
 
   std::set< CSetContent * >::const_iterator it = mSets.begin();
   std::set< CSetContent * >::const_iterator end = mSets.end();
 
   for (; it != end; ++it)
     {
-      SetContent & Active = (*it)->activeContent();
-
-      if (first)
-        {
-          *pOut = Active;
-          DBFieldValues = Active.dBFieldValues;
+      const SetContent & Content = (*it)->activeContent();
 
-          first = false;
-        }
-      else
-        {
-          pOut->clear();
+      Nodes.push_back(&Content.mNodes);
+      Edges.push_back(&Content.edges);
 
-          std::set_union(Active.edges.begin(), Active.edges.end(), pIn->edges.begin(), pIn->edges.end(), std::back_inserter(pOut->edges));
-          std::set_union(Active.mNodes.begin(), Active.mNodes.end(), pIn->mNodes.begin(), pIn->mNodes.end(), std::back_inserter(pOut->mNodes));
+      CDBFieldValues::const_iterator itDB = Content.dBFieldValues.begin();
+      CDBFieldValues::const_iterator endDB = Content.dBFieldValues.end();
 
-          CDBFieldValues::const_iterator itDB = Active.dBFieldValues.begin();
-          CDBFieldValues::const_iterator endDB = Active.dBFieldValues.end();
-
-          for (; itDB != endDB; ++itDB)
-            DBFieldValues[itDB->first].insert(itDB->second.begin(), itDB->second.end());
-        }
-      
-      std::swap(pIn, pOut);
+      for (; itDB != endDB; ++itDB)
+        DBFieldValues[itDB->first].insert(itDB->second.begin(), itDB->second.end());
     }
 
-  Active.edges = pIn->edges;
-  Active.mNodes = pIn->mNodes;
+  CNetwork & Network = CNetwork::Context.Active();
+
+  CSetBitmap< CNode >::unite(Nodes, Network.beginNode(), Network.endNode(), Active.mNodes);
+  CSetBitmap< CEdge >::unite(Edges, Network.beginEdge(), Network.endEdge(), Active.edges);
 
   if (CLogger::level() <= CLogger::LogLevel::debug)
     {
@@ -230,52 +293,50 @@ bool CSetOperation::computeUnion()
 
 bool CSetOperation::computeIntersection()
 {
-  SetContent C1, C2, *pIn, *pOut;
-  pIn = &C1;
-  pOut = &C2;
-
-  bool first = true;
+  SetContent & Active = activeContent();
+  CDBFieldValues & DBFieldValues = Active.dBFieldValues;
 
+  CSetBitmap< CNode >::operands Nodes;
+  CSetBitmap< CEdge >::operands Edges;
 
   std::set< CSetContent * >::const_iterator it = mSets.begin();
   std::set< CSetContent * >::const_iterator end = mSets.end();
 
   for (; it != end; ++it)
     {
-      SetContent & Active = (*it)->activeContent();
+      const SetContent & Content = (*it)->activeContent();
 
-      if (first)
+      Nodes.push_back(&Content.mNodes);
+      Edges.push_back(&Content.edges);
+
+      if (it == mSets.begin())
         {
-          *pOut = Active;
-          first = false;
+          DBFieldValues = Content.dBFieldValues;
+          continue;
         }
-      else
-        {
-          pOut->clear();
 
-          std::set_intersection(pIn->edges.begin(), pIn->edges.end(), Active.edges.begin(), Active.edges.end(), std::inserter(pOut->edges, pOut->edges.begin()));
-          std::set_intersection(pIn->mNodes.begin(), pIn->mNodes.end(), Active.mNodes.begin(), Active.mNodes.end(), std::inserter(pOut->mNodes, pOut->mNodes.begin()));
+      CDBFieldValues In;
+      std::swap(In, DBFieldValues);
 
-          CDBFieldValues::const_iterator itDB = Active.dBFieldValues.begin();
-          CDBFieldValues::const_iterator endDB = Active.dBFieldValues.end();
+      CDBFieldValues::const_iterator itDB = Content.dBFieldValues.begin();
+      CDBFieldValues::const_iterator endDB = Content.dBFieldValues.end();
 
-          for (; itDB != endDB; ++itDB)
-            {
-              CDBFieldValues::iterator In = pIn->dBFieldValues.find(itDB->first);
+      for (; itDB != endDB; ++itDB)
+        {
+          CDBFieldValues::const_iterator found = In.find(itDB->first);
 
-              if (In != pIn->dBFieldValues.end())
-                {
-                  CValueList & Out = pOut->dBFieldValues[itDB->first];
-                  std::set_intersection(In->second.begin(), In->second.end(), itDB->second.begin(), itDB->second.end(), std::inserter(Out, Out.begin()));
-                }
+          if (found != In.end())
+            {
+              CValueList & Out = DBFieldValues[itDB->first];
+              std::set_intersection(found->second.begin(), found->second.end(), itDB->second.begin(), itDB->second.end(), std::inserter(Out, Out.begin()));
             }
         }
-
-      std::swap(pIn, pOut);
     }
 
-  SetContent & Active = activeContent();
-  Active = *pIn;
+  CNetwork & Network = CNetwork::Context.Active();
+
+  CSetBitmap< CNode >::intersect(Nodes, Network.beginNode(), Network.endNode(), Active.mNodes);
+  CSetBitmap< CEdge >::intersect(Edges, Network.beginEdge(), Network.endEdge(), Active.edges);
 
   if (CLogger::level() <= CLogger::LogLevel::debug)
     {
@@ -38,6 +38,12 @@ public:
 
   virtual ~CSetOperation();
 
+  virtual void determineIsStatic() override;
+
+  virtual bool filter(const CNode * pNode) const override;
+
+  virtual bool filter(const CEdge * pEdge) const override;
+
 protected:
   virtual bool computeSetContent() override;
 
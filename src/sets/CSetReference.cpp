@@ -163,3 +163,22 @@ std::string CSetReference::getComputableId() const
 
   return os.str();
 }
+
+// virtual
+void CSetReference::registerDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  // The content is shared with the referenced set which reports all changes
+  if (mValid && mpSet != NULL)
+    mpSet->registerDependentCollector(pCollector);
+  else
+    CSetContent::registerDependentCollector(pCollector);
+}
+
+// virtual
+void CSetReference::deregisterDependentCollector(std::shared_ptr< CSetCollectorInterface > pCollector)
+{
+  if (mValid && mpSet != NULL)
+    mpSet->deregisterDependentCollector(pCollector);
+
+  CSetContent::deregisterDependentCollector(pCollector);
+}
@@ -141,9 +141,46 @@ void CCommunicate::init(int /* argc */ , char ** /* argv */)
       }
   }
 
+  // Determine which processes run on the same host
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, MPIRank, MPI_INFO_NULL, &MPIHostCommunicator);
+  MPI_Comm_size(MPIHostCommunicator, &MPIHostProcesses);
+
+  // Failures to allocate shared memory are handled by falling back to messages
+  MPI_Comm_set_errhandler(MPIHostCommunicator, MPI_ERRORS_RETURN);
+
+  MPI_Group WorldGroup;
+  MPI_Group HostGroup;
+  MPI_Comm_group(MPI_COMM_WORLD, &WorldGroup);
+  MPI_Comm_group(MPIHostCommunicator, &HostGroup);
+
+  int * WorldRanks = new int[MPIProcesses];
+  HostRanks = new int[MPIProcesses];
+
+  for (int i = 0; i < MPIProcesses; ++i)
+    WorldRanks[i] = i;
+
+  MPI_Group_translate_ranks(WorldGroup, MPIProcesses, WorldRanks, HostGroup, HostRanks);
+
+  for (int i = 0; i < MPIProcesses; ++i)
+    if (HostRanks[i] == MPI_UNDEFINED)
+      HostRanks[i] = -1;
+
+  delete[] WorldRanks;
+  MPI_Group_free(&WorldGroup);
+  MPI_Group_free(&HostGroup);
+
 #endif // USE_MPI
 }
 
+// static
+int CCommunicate::hostRank(const int & rank)
+{
+  if (HostRanks == NULL)
+    return rank == MPIRank ? 0 : -1;
+
+  return HostRanks[rank];
+}
+
 // static 
 int CCommunicate::LocalThreadIndex()
 {
@@ -202,6 +239,13 @@ int CCommunicate::finalize(void)
         delete[] RMABuffer;
     }
 
+  if (HostRanks != NULL)
+    {
+      delete[] HostRanks;
+      HostRanks = NULL;
+      MPI_Comm_free(&MPIHostCommunicator);
+    }
+
   return MPI_Finalize();
 #else
   return MPI_SUCCESS;
@@ -222,8 +222,15 @@ public:
   static int MPIProcesses;
   static MPI_Comm * MPICommunicator;
 
+  // The processes sharing memory with this process, i.e., running on the same host
+  static MPI_Comm MPIHostCommunicator;
+  static int MPIHostProcesses;
+
   static void init(int argc, char ** argv);
 
+  // The rank of the process within the host communicator or -1 if it runs on a different host
+  static int hostRank(const int & rank);
+
   static int LocalThreadIndex();
 
   static int GlobalThreadIndex();
@@ -282,6 +289,7 @@ public:
 private:
   static int ReceiveSize;
   static char * ReceiveBuffer;
+  static int * HostRanks;
   static size_t MPIWinSize;
   static double * RMABuffer;
   static size_t RMAIndex;
@@ -0,0 +1,90 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <cmath>
+#include <cstdio>
+
+#include "utilities/CFormatBuffer.h"
+
+// static
+const char CFormatBuffer::Digits[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+CFormatBuffer::CFormatBuffer(const size_t & capacity)
+  : mpBegin(new char[capacity > 0 ? capacity : 1])
+  , mpEnd(mpBegin)
+  , mpCapacity(mpBegin + (capacity > 0 ? capacity : 1))
+{}
+
+CFormatBuffer::CFormatBuffer(const CFormatBuffer & src)
+  : mpBegin(new char[src.mpCapacity - src.mpBegin])
+  , mpEnd(mpBegin + src.size())
+  , mpCapacity(mpBegin + (src.mpCapacity - src.mpBegin))
+{
+  memcpy(mpBegin, src.mpBegin, src.size());
+}
+
+CFormatBuffer::~CFormatBuffer()
+{
+  delete[] mpBegin;
+}
+
+CFormatBuffer & CFormatBuffer::operator=(const CFormatBuffer & rhs)
+{
+  if (this != &rhs)
+    {
+      clear();
+      append(rhs.mpBegin, rhs.mpEnd);
+    }
+
+  return *this;
+}
+
+// static
+char * CFormatBuffer::toChars(char * pBuffer, double value)
+{
+  // Integral values with at most 6 significant digits are printed by "%g" without
+  // exponent and decimal point, i.e., identical to their integer representation.
+  // Negative zero must be excluded as it is printed as "-0".
+  if (value > -1e6 && value < 1e6)
+    {
+      long long Integer = (long long) value;
+
+      if ((double) Integer == value
+          && !(Integer == 0 && std::signbit(value)))
+        return toChars(pBuffer, Integer);
+    }
+
+  // The buffer must hold at least 32 characters.
+  return pBuffer + snprintf(pBuffer, 32, "%g", value);
+}
@@ -0,0 +1,263 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CFORMATBUFFER_H_
+#define SRC_UTILITIES_CFORMATBUFFER_H_
+
+#include <string>
+#include <iostream>
+#include <cstring>
+
+/**
+ * A reusable character buffer for the text writers. Numbers are formatted
+ * without the locale and virtual dispatch of std::ostream, the produced bytes
+ * are identical to the default formatting of std::ostream. Clearing the buffer
+ * keeps its capacity so that a buffer owned by a thread is allocated only once.
+ */
+class CFormatBuffer
+{
+public:
+  CFormatBuffer(const size_t & capacity = 256);
+
+  CFormatBuffer(const CFormatBuffer & src);
+
+  ~CFormatBuffer();
+
+  CFormatBuffer & operator=(const CFormatBuffer & rhs);
+
+  CFormatBuffer & operator<<(const char & value);
+  CFormatBuffer & operator<<(const char * value);
+  CFormatBuffer & operator<<(const std::string & value);
+  CFormatBuffer & operator<<(const bool & value);
+  CFormatBuffer & operator<<(const int & value);
+  CFormatBuffer & operator<<(const long & value);
+  CFormatBuffer & operator<<(const long long & value);
+  CFormatBuffer & operator<<(const unsigned int & value);
+  CFormatBuffer & operator<<(const unsigned long & value);
+  CFormatBuffer & operator<<(const unsigned long long & value);
+  CFormatBuffer & operator<<(const double & value);
+
+  const char * data() const;
+  size_t size() const;
+  bool empty() const;
+  void clear();
+
+  /**
+   * Write the content of the buffer to the stream and clear the buffer
+   */
+  std::ostream & flush(std::ostream & os);
+
+  // Write the decimal representation into pBuffer and return the end of the written characters
+  static char * toChars(char * pBuffer, unsigned long long value);
+  static char * toChars(char * pBuffer, long long value);
+
+  // The same output as std::ostream with default precision and floatfield, i.e., printf("%g")
+  static char * toChars(char * pBuffer, double value);
+
+private:
+  char * reserve(const size_t & size);
+  void append(const char * pBegin, const char * pEnd);
+
+  static const char Digits[201];
+
+  char * mpBegin;
+  char * mpEnd;
+  char * mpCapacity;
+};
+
+inline char * CFormatBuffer::reserve(const size_t & size)
+{
+  if ((size_t) (mpCapacity - mpEnd) < size)
+    {
+      size_t Size = mpEnd - mpBegin;
+      size_t Capacity = 2 * (mpCapacity - mpBegin) + size;
+      char * pBegin = new char[Capacity];
+
+      memcpy(pBegin, mpBegin, Size);
+      delete[] mpBegin;
+
+      mpBegin = pBegin;
+      mpEnd = pBegin + Size;
+      mpCapacity = pBegin + Capacity;
+    }
+
+  return mpEnd;
+}
+
+inline void CFormatBuffer::append(const char * pBegin, const char * pEnd)
+{
+  memcpy(reserve(pEnd - pBegin), pBegin, pEnd - pBegin);
+  mpEnd += pEnd - pBegin;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const char & value)
+{
+  *reserve(1) = value;
+  ++mpEnd;
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const char * value)
+{
+  append(value, value + strlen(value));
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const std::string & value)
+{
+  append(value.data(), value.data() + value.size());
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const bool & value)
+{
+  return operator<<(value ? '1' : '0');
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const int & value)
+{
+  mpEnd = toChars(reserve(24), (long long) value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const long & value)
+{
+  mpEnd = toChars(reserve(24), (long long) value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const long long & value)
+{
+  mpEnd = toChars(reserve(24), value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const unsigned int & value)
+{
+  mpEnd = toChars(reserve(24), (unsigned long long) value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const unsigned long & value)
+{
+  mpEnd = toChars(reserve(24), (unsigned long long) value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const unsigned long long & value)
+{
+  mpEnd = toChars(reserve(24), value);
+
+  return *this;
+}
+
+inline CFormatBuffer & CFormatBuffer::operator<<(const double & value)
+{
+  mpEnd = toChars(reserve(32), value);
+
+  return *this;
+}
+
+inline const char * CFormatBuffer::data() const
+{
+  return mpBegin;
+}
+
+inline size_t CFormatBuffer::size() const
+{
+  return mpEnd - mpBegin;
+}
+
+inline bool CFormatBuffer::empty() const
+{
+  return mpEnd == mpBegin;
+}
+
+inline void CFormatBuffer::clear()
+{
+  mpEnd = mpBegin;
+}
+
+inline std::ostream & CFormatBuffer::flush(std::ostream & os)
+{
+  os.write(mpBegin, mpEnd - mpBegin);
+  clear();
+
+  return os;
+}
+
+// static
+inline char * CFormatBuffer::toChars(char * pBuffer, unsigned long long value)
+{
+  char Reverse[24];
+  char * pReverse = Reverse + 24;
+
+  while (value >= 100)
+    {
+      const char * pDigits = Digits + 2 * (value % 100);
+      value /= 100;
+
+      *--pReverse = pDigits[1];
+      *--pReverse = pDigits[0];
+    }
+
+  if (value >= 10)
+    {
+      *--pReverse = Digits[2 * value + 1];
+      *--pReverse = Digits[2 * value];
+    }
+  else
+    {
+      *--pReverse = (char) ('0' + value);
+    }
+
+  size_t Size = Reverse + 24 - pReverse;
+  memcpy(pBuffer, pReverse, Size);
+
+  return pBuffer + Size;
+}
+
+// static
+inline char * CFormatBuffer::toChars(char * pBuffer, long long value)
+{
+  if (value < 0)
+    {
+      *pBuffer++ = '-';
+
+      // Avoid overflow for the smallest representable value
+      return toChars(pBuffer, 0ULL - (unsigned long long) value);
+    }
+
+  return toChars(pBuffer, (unsigned long long) value);
+}
+
+#endif /* SRC_UTILITIES_CFORMATBUFFER_H_ */
@@ -0,0 +1,96 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <algorithm>
+
+#include "utilities/CGuideTable.h"
+
+CGuideTable::CGuideTable()
+  : mCumulative()
+  , mGuide()
+  , mScale(0.0)
+{}
+
+void CGuideTable::init(const std::vector< double > & propensities)
+{
+  mCumulative.resize(propensities.size());
+  mGuide.resize(propensities.size());
+  mScale = 0.0;
+
+  if (propensities.empty())
+    return;
+
+  std::vector< double >::const_iterator it = propensities.begin();
+  std::vector< double >::const_iterator end = propensities.end();
+  std::vector< double >::iterator itCumulative = mCumulative.begin();
+  double Total = 0.0;
+
+  for (; it != end; ++it, ++itCumulative)
+    {
+      Total += *it;
+      *itCumulative = Total;
+    }
+
+  if (Total > 0.0)
+    mScale = mGuide.size() / Total;
+
+  // The guide entry j points to the first item whose cumulative propensity exceeds j * Total / size.
+  size_t Last = mCumulative.size() - 1;
+  size_t Item = 0;
+
+  for (size_t j = 0, jmax = mGuide.size(); j < jmax; ++j)
+    {
+      double Threshold = j * Total / jmax;
+
+      while (Item < Last && mCumulative[Item] <= Threshold)
+        ++Item;
+
+      mGuide[j] = Item;
+    }
+}
+
+size_t CGuideTable::index(const double & alpha) const
+{
+  size_t Last = mCumulative.size() - 1;
+  size_t Item = mGuide[std::min(static_cast< size_t >(alpha * mScale), Last)];
+
+  // Correct the start for rounding in the scaling of alpha
+  while (Item > 0 && mCumulative[Item - 1] > alpha)
+    --Item;
+
+  while (Item < Last && mCumulative[Item] <= alpha)
+    ++Item;
+
+  return Item;
+}
+
+const double & CGuideTable::total() const
+{
+  return mCumulative.back();
+}
+
+bool CGuideTable::empty() const
+{
+  return mCumulative.empty();
+}
@@ -0,0 +1,58 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CGUIDETABLE_H_
+#define SRC_UTILITIES_CGUIDETABLE_H_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Inversion sampling of a discrete distribution given by non negative propensities. The guide table points
+ * for each of its equally sized intervals of [0, total) to the first candidate item, i.e., a lookup needs in
+ * expectation a constant number of comparisons. The result is the same as the one of a linear scan of the
+ * cumulative propensities, which preserves the mapping of random numbers to items.
+ */
+class CGuideTable
+{
+public:
+  CGuideTable();
+
+  // Build the table for the given propensities
+  void init(const std::vector< double > & propensities);
+
+  // Retrieve the index of the item for alpha in [0, total()]
+  size_t index(const double & alpha) const;
+
+  const double & total() const;
+
+  bool empty() const;
+
+private:
+  std::vector< double > mCumulative;
+  std::vector< size_t > mGuide;
+  double mScale;
+};
+
+#endif /* SRC_UTILITIES_CGUIDETABLE_H_ */
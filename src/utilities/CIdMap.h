@@ -0,0 +1,145 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CIDMAP_H_
+#define SRC_UTILITIES_CIDMAP_H_
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * A flat open addressing hash map from ids to pointers using linear probing. Lookups touch a single contiguous
+ * array instead of following the nodes of a tree. Entries can not be removed.
+ */
+template < class Type > class CIdMap
+{
+public:
+  CIdMap();
+
+  // Remove all entries and reserve space for the given number of entries
+  void init(const size_t & size);
+
+  void insert(const size_t & id, Type * pValue);
+
+  // Retrieve the value for the id or NULL if none exists
+  Type * find(const size_t & id) const;
+
+  const size_t & size() const;
+
+private:
+  typedef std::pair< size_t, Type * > Slot;
+
+  size_t index(const size_t & id) const;
+
+  static const size_t Empty;
+
+  std::vector< Slot > mSlots;
+  size_t mMask;
+  size_t mShift;
+  size_t mSize;
+};
+
+template < class Type > const size_t CIdMap< Type >::Empty = std::numeric_limits< size_t >::max();
+
+template < class Type > CIdMap< Type >::CIdMap()
+  : mSlots()
+  , mMask(0)
+  , mShift(0)
+  , mSize(0)
+{}
+
+template < class Type > void CIdMap< Type >::init(const size_t & size)
+{
+  // The load factor is kept at or below 0.5
+  size_t Capacity = 2;
+  mShift = 63;
+
+  while (Capacity < 2 * size)
+    {
+      Capacity <<= 1;
+      --mShift;
+    }
+
+  mSlots.assign(Capacity, Slot(Empty, NULL));
+  mMask = Capacity - 1;
+  mSize = 0;
+}
+
+template < class Type > size_t CIdMap< Type >::index(const size_t & id) const
+{
+  // Fibonacci hashing uses the high bits of the product
+  return (id * 0x9E3779B97F4A7C15ULL) >> mShift;
+}
+
+template < class Type > void CIdMap< Type >::insert(const size_t & id, Type * pValue)
+{
+  if (2 * (mSize + 1) > mSlots.size())
+    {
+      std::vector< Slot > Slots;
+      Slots.swap(mSlots);
+      init(mSize + 1);
+
+      for (const Slot & Slot : Slots)
+        if (Slot.first != Empty)
+          insert(Slot.first, Slot.second);
+    }
+
+  size_t Index = index(id);
+
+  while (mSlots[Index].first != Empty
+         && mSlots[Index].first != id)
+    Index = (Index + 1) & mMask;
+
+  if (mSlots[Index].first == Empty)
+    ++mSize;
+
+  mSlots[Index] = Slot(id, pValue);
+}
+
+template < class Type > Type * CIdMap< Type >::find(const size_t & id) const
+{
+  if (mSize == 0)
+    return NULL;
+
+  size_t Index = index(id);
+
+  while (mSlots[Index].first != Empty)
+    {
+      if (mSlots[Index].first == id)
+        return mSlots[Index].second;
+
+      Index = (Index + 1) & mMask;
+    }
+
+  return NULL;
+}
+
+template < class Type > const size_t & CIdMap< Type >::size() const
+{
+  return mSize;
+}
+
+#endif /* SRC_UTILITIES_CIDMAP_H_ */
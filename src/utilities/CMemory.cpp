@@ -0,0 +1,110 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <algorithm>
+#include <fstream>
+#include <sys/mman.h>
+
+#include "utilities/CMemory.h"
+#include "utilities/CCommunicate.h"
+#include "utilities/CLogger.h"
+
+// static
+bool CMemory::HugePages(false);
+
+// static
+void CMemory::setHugePages(const bool & hugePages)
+{
+  HugePages = hugePages;
+}
+
+// static
+void * CMemory::map(const size_t & bytes)
+{
+  if (bytes == 0)
+    return NULL;
+
+  // Anonymous mappings are backed by physical pages only when they are first written.
+  void * pMemory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (pMemory == MAP_FAILED)
+    throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+  if (HugePages
+      && madvise(pMemory, bytes, MADV_HUGEPAGE) != 0)
+    CLogger::warn("CMemory::map: Huge pages are not available.");
+#endif // MADV_HUGEPAGE
+
+  return pMemory;
+}
+
+// static
+void CMemory::unmap(void * pMemory, const size_t & bytes)
+{
+  if (pMemory != NULL)
+    munmap(pMemory, bytes);
+}
+
+// static
+size_t CMemory::numaDomains()
+{
+  // The online NUMA nodes are listed as ranges, e.g., 0-1,3
+  std::ifstream is("/sys/devices/system/node/online");
+
+  if (is.fail())
+    return 1;
+
+  size_t Domains = 0;
+  size_t First = 0;
+  size_t Last = 0;
+  char Separator = ',';
+
+  while (Separator == ',' && is >> First)
+    {
+      Last = First;
+      Separator = is.get();
+
+      if (Separator == '-')
+        {
+          is >> Last;
+          Separator = is.get();
+        }
+
+      Domains += Last - First + 1;
+    }
+
+  return std::max< size_t >(Domains, 1);
+}
+
+// static
+void CMemory::logLayout()
+{
+  size_t Domains = numaDomains();
+
+  CLogger::info("CMemory: NUMA domains: {}, MPI processes: {}, threads per process: {}.", Domains, CCommunicate::MPIProcesses, omp_get_max_threads());
+
+  if (Domains > 1)
+    CLogger::info("CMemory: For best memory locality run one MPI process per NUMA domain with its threads bound to the domain (e.g., OMP_PROC_BIND=close).");
+}
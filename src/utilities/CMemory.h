@@ -0,0 +1,88 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CMEMORY_H_
+#define SRC_UTILITIES_CMEMORY_H_
+
+#include <cstddef>
+#include <new>
+
+/**
+ * Allocation of the large node and edge arrays. The memory is mapped without being touched, so that each page is
+ * placed on the NUMA domain of the thread which first writes it. The elements are constructed by the owning thread
+ * of each slice.
+ */
+class CMemory
+{
+public:
+  template < class Type > static Type * allocate(const size_t & size);
+
+  template < class Type > static void construct(Type * pBegin, Type * pEnd);
+
+  template < class Type > static void release(Type * pArray, const size_t & size);
+
+  static void setHugePages(const bool & hugePages);
+
+  // Log the NUMA domains of the host and the recommended process layout
+  static void logLayout();
+
+private:
+  static void * map(const size_t & bytes);
+
+  static void unmap(void * pMemory, const size_t & bytes);
+
+  static size_t numaDomains();
+
+  static bool HugePages;
+};
+
+// static
+template < class Type > Type * CMemory::allocate(const size_t & size)
+{
+  return static_cast< Type * >(map(size * sizeof(Type)));
+}
+
+// static
+template < class Type > void CMemory::construct(Type * pBegin, Type * pEnd)
+{
+  for (; pBegin != pEnd; ++pBegin)
+    new (pBegin) Type();
+}
+
+// static
+template < class Type > void CMemory::release(Type * pArray, const size_t & size)
+{
+  if (pArray == NULL)
+    return;
+
+  Type * pIt = pArray;
+  Type * pEnd = pArray + size;
+
+  for (; pIt != pEnd; ++pIt)
+    pIt->~Type();
+
+  unmap(pArray, size * sizeof(Type));
+}
+
+#endif /* SRC_UTILITIES_CMEMORY_H_ */
@@ -25,6 +25,7 @@
 #include "utilities/CRandom.h"
 
 #include "CSimConfig.h"
+#include "actions/CActionQueue.h"
 #include "utilities/CCommunicate.h"
 
 CRandom::result_t CRandom::debug_generator::operator()()
@@ -36,6 +37,60 @@ CRandom::result_t CRandom::debug_generator::operator()()
   return r;
 }
 
+CRandom::CGenerator::CGenerator()
+  : base()
+  , mKey{0, 0}
+  , mStreamKey{0, 0}
+  , mCounter{0, 0, 0, 0}
+{}
+
+void CRandom::CGenerator::setKey(const result_type & key)
+{
+  mKey[0] = (uint32_t) key;
+  mKey[1] = (uint32_t) (key >> 32);
+  mStreamKey[0] = mKey[0];
+  mStreamKey[1] = mKey[1];
+}
+
+void CRandom::CGenerator::seek(const size_t & entity, const Stream & stream, const size_t & salt)
+{
+  // The salt is combined with the key so that all of its bits are used and the first counter word
+  // is solely the index of the draw.
+  mStreamKey[0] = mKey[0] ^ (uint32_t) salt;
+  mStreamKey[1] = mKey[1] ^ (uint32_t) (salt >> 32);
+  mCounter[0] = 0;
+  mCounter[1] = (uint32_t) entity;
+  mCounter[2] = (uint32_t) (entity >> 32) | ((uint32_t) stream << 24);
+  mCounter[3] = (uint32_t) (int) CActionQueue::getCurrentTick();
+}
+
+CRandom::result_t CRandom::CGenerator::next()
+{
+  static const uint32_t M0 = 0xD2511F53;
+  static const uint32_t M1 = 0xCD9E8D57;
+  static const uint32_t W0 = 0x9E3779B9;
+  static const uint32_t W1 = 0xBB67AE85;
+
+  uint32_t Block[4] = {mCounter[0]++, mCounter[1], mCounter[2], mCounter[3]};
+  uint32_t Key[2] = {mStreamKey[0], mStreamKey[1]};
+
+  for (int Round = 0; Round < 10; ++Round)
+    {
+      uint64_t Product0 = (uint64_t) M0 * Block[0];
+      uint64_t Product1 = (uint64_t) M1 * Block[2];
+
+      Block[0] = (uint32_t) (Product1 >> 32) ^ Block[1] ^ Key[0];
+      Block[1] = (uint32_t) Product1;
+      Block[2] = (uint32_t) (Product0 >> 32) ^ Block[3] ^ Key[1];
+      Block[3] = (uint32_t) Product0;
+
+      Key[0] += W0;
+      Key[1] += W1;
+    }
+
+  return ((result_t) Block[0] << 32) | Block[1];
+}
+
 CRandom::generator_t & CRandom::CContext::Active()
 {
   // Master is not initialized and must not be used
@@ -45,6 +100,9 @@ CRandom::generator_t & CRandom::CContext::Active()
 // static 
 bool CRandom::mHaveSeed = false;
 
+// static 
+bool CRandom::CounterBased = false;
+
 // static 
 CRandom::result_t CRandom::mSeed = std::numeric_limits< CRandom::result_t >::max();
 
@@ -52,6 +110,7 @@ CRandom::result_t CRandom::mSeed = std::numeric_limits< CRandom::result_t >::max
 void CRandom::init(size_t seed)
 {
   CRandom::G.init();
+  CounterBased = CSimConfig::getCounterBasedRandom();
 
   mHaveSeed = (seed != std::numeric_limits< size_t >::max());
 
@@ -90,6 +149,10 @@ void CRandom::seed(CRandom::result_t value)
 
   CCommunicate::broadcast(Seeds, sizeof(result_t) * TotalSeeds, 0);
 
+  // The key of the counter based generator must be the same for all threads
+  result_t Key = value;
+  CCommunicate::broadcast(&Key, sizeof(result_t), 0);
+
   generator_t * pIt = G.beginThread();  
   generator_t * pEnd = G.endThread();
 
@@ -99,6 +162,7 @@ void CRandom::seed(CRandom::result_t value)
         CLogger::debug("CRandom::seed: Seeding thread {} with: {}", G.globalIndex(pIt), Seeds[G.globalIndex(pIt)]);
 
       pIt->seed(Seeds[G.globalIndex(pIt)]);
+      pIt->setKey(Key);
     }  
 }
 
@@ -26,6 +26,7 @@
 #define SRC_UTILITIES_CRANDOM_H_
 
 #include <random>
+#include <cstdint>
 
 #include "utilities/CContext.h"
 
@@ -38,8 +39,56 @@ public:
     std::mt19937_64::result_type operator()();
   };
 
-  // Change to CGe
-  typedef std::mt19937_64 generator_t;
+  // The purpose of draws from a counter based stream
+  enum struct Stream
+  {
+    transmission,
+    progression,
+    dwellTime,
+    sampling
+  };
+
+  /**
+   * The generator is either a sequential Mersenne Twister per thread or a counter based Philox4x32-10
+   * generator. The key is the seed combined with a salt and the counter is the entity id, the stream, the tick,
+   * and the index of the draw.
+   * Counter based draws therefore only depend on the seed and the entity and not on the decomposition.
+   */
+  class CGenerator : public std::mt19937_64
+  {
+  public:
+    typedef std::mt19937_64 base;
+
+    CGenerator();
+
+    result_type operator()()
+    {
+      if (!CounterBased)
+        return base::operator()();
+
+      return next();
+    }
+
+    void setKey(const result_type & key);
+
+    // Select the counter based stream for the entity (no-op for the sequential generator)
+    void setStream(const size_t & entity, const Stream & stream, const size_t & salt = 0)
+    {
+      if (CounterBased)
+        seek(entity, stream, salt);
+    }
+
+  private:
+    void seek(const size_t & entity, const Stream & stream, const size_t & salt);
+
+    result_type next();
+
+    uint32_t mKey[2];
+    uint32_t mStreamKey[2];
+    uint32_t mCounter[4];
+  };
+
+  typedef CGenerator generator_t;
   typedef generator_t::result_type result_t;
 
   template < class CType > struct DistributionContext
@@ -84,6 +133,13 @@ public:
     result_type sample() const
     {
       const context_type & Active = base::Active();
+
+      // Counter based draws must not depend on values cached by the distribution and use the stream of the active thread.
+      if (CRandom::CounterBased)
+        {
+          Active.distribution.reset();
+          return Active.distribution.operator()(CRandom::G.Active());
+        }
       
       return Active.distribution.operator()(*Active.pGenerator);
     }
@@ -105,6 +161,8 @@ public:
 
   static CContext G;
 
+  static bool CounterBased;
+
 private:
   static bool mHaveSeed;
   static result_t mSeed;
@@ -143,6 +143,12 @@ const std::map< int, size_t > & CSimConfig::getReseed()
 // static
 const size_t & CSimConfig::getReplicate()
 {
+  // The model analyzer seeds the random number generator without a simulation configuration
+  static const size_t NoReplicate(std::numeric_limits< size_t >::max());
+
+  if (CSimConfig::INSTANCE == NULL)
+    return NoReplicate;
+
   return CSimConfig::INSTANCE->mReplicate;
 }
 
@@ -152,6 +158,28 @@ const size_t & CSimConfig::getPartitionEdgeLimit()
   return CSimConfig::INSTANCE->mPartitionEdgeLimit;
 }
 
+// static
+const bool & CSimConfig::getCounterBasedRandom()
+{
+  static const bool Sequential(false);
+
+  if (CSimConfig::INSTANCE == NULL)
+    return Sequential;
+
+  return CSimConfig::INSTANCE->mCounterBasedRandom;
+}
+
+// static
+const bool & CSimConfig::getHugePages()
+{
+  static const bool HugePages(false);
+
+  if (CSimConfig::INSTANCE == NULL)
+    return HugePages;
+
+  return CSimConfig::INSTANCE->mHugePages;
+}
+
 // static
 CLogger::LogLevel CSimConfig::getLogLevel()
 {
@@ -194,6 +222,8 @@ CSimConfig::CSimConfig(const std::string & configFile)
   , mReseed()
   , mReplicate(std::numeric_limits< size_t >::max())
   , mPartitionEdgeLimit(100000000)
+  , mCounterBasedRandom(false)
+  , mHugePages(false)
   , mDBConnection()
 {
   if (mRunParameters.empty())
@@ -279,6 +309,18 @@ CSimConfig::CSimConfig(const std::string & configFile)
       "description": "The number of the replicate created with the job",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
+    "randomNumberGenerator": {
+      "description": "The random number generator; counterBased draws depend only on the seed and the node or edge and not on the number of processes and threads (default: sequential)",
+      "type": "string",
+      "enum": [
+        "sequential",
+        "counterBased"
+      ]
+    },
+    "hugePages": {
+      "description": "Back the node and edge arrays with transparent huge pages (default: false)",
+      "type": "boolean"
+    },
     "partitionEdgeLimit": {
       "description": "The maximum number of network edges which are partitioned on the fly.",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
@@ -313,7 +355,7 @@ CSimConfig::CSimConfig(const std::string & configFile)
       "type": "string"
     },
     "dbMaxRecords": {
-      "description": "The maximal number of records returned by a single query (default: 100,000; 0: unlimited)",
+      "description": "The number of records fetched from the server side cursor at once (default: 100,000; 0: unlimited)",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
     "dbConnectionTimeout": {
@@ -330,6 +372,18 @@ CSimConfig::CSimConfig(const std::string & configFile)
       "description": "The maximal delay in milli seconds for attempting a connection (default: 500)",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
+    "dbConnectionPerThread": {
+      "description": "Open a separate connection for each thread so that threads query concurrently (default: false)",
+      "type": "boolean"
+    },
+    "dbBackend": {
+      "description": "The backend evaluating person trait queries; embedded loads the rows of the person trait DB files within the node range of the network into the memory of each process (default: postgresql)",
+      "type": "string",
+      "enum": [
+        "postgresql",
+        "embedded"
+      ]
+    },
     "dumpActiveNetwork": {
       "type": "object",
       "description": "If present causes regular dumps of the active network",
@@ -518,6 +572,20 @@ CSimConfig::CSimConfig(const std::string & configFile)
       mReplicate = json_real_value(pValue);
     }
 
+  pValue = json_object_get(pRoot, "randomNumberGenerator");
+
+  if (json_is_string(pValue))
+    {
+      mCounterBasedRandom = (strcmp(json_string_value(pValue), "counterBased") == 0);
+    }
+
+  pValue = json_object_get(pRoot, "hugePages");
+
+  if (json_is_boolean(pValue))
+    {
+      mHugePages = json_is_true(pValue);
+    }
+
   pValue = json_object_get(pRoot, "partitionEdgeLimit");
 
   if (json_is_real(pValue))
@@ -556,6 +624,8 @@ CSimConfig::CSimConfig(const std::string & configFile)
   mDBConnection.connectionTimeout = 2;
   mDBConnection.connectionRetries = 15;
   mDBConnection.connectionMaxDelay = 500;
+  mDBConnection.embedded = false;
+  mDBConnection.connectionPerThread = false;
 
   pValue = json_object_get(pRoot, "dbName");
 
@@ -613,6 +683,20 @@ CSimConfig::CSimConfig(const std::string & configFile)
       mDBConnection.connectionMaxDelay = json_real_value(pValue);
     }
 
+  pValue = json_object_get(pRoot, "dbConnectionPerThread");
+
+  if (json_is_boolean(pValue))
+    {
+      mDBConnection.connectionPerThread = json_is_true(pValue);
+    }
+
+  pValue = json_object_get(pRoot, "dbBackend");
+
+  if (json_is_string(pValue))
+    {
+      mDBConnection.embedded = (strcmp(json_string_value(pValue), "embedded") == 0);
+    }
+
   mDumpActiveNetwork.output = "";
   mDumpActiveNetwork.threshold = -1.0;
   mDumpActiveNetwork.startTick = mStartTick;
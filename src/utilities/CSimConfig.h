@@ -47,6 +47,8 @@ public:
     size_t connectionTimeout = 2;
     size_t connectionRetries = 15;
     size_t connectionMaxDelay = 500;
+    bool embedded = false;
+    bool connectionPerThread = false;
   };
 
   struct dump_active_network
@@ -84,6 +86,8 @@ private:
   std::map< int, size_t > mReseed;
   size_t mReplicate;
   size_t mPartitionEdgeLimit;
+  bool mCounterBasedRandom;
+  bool mHugePages;
   CLogger::LogLevel mLogLevel;
   db_connection mDBConnection;
   dump_active_network mDumpActiveNetwork;
@@ -118,6 +122,8 @@ public:
   static const std::map< int, size_t> & getReseed();
   static const size_t & getReplicate();
   static const size_t & getPartitionEdgeLimit();
+  static const bool & getCounterBasedRandom();
+  static const bool & getHugePages();
   static CLogger::LogLevel getLogLevel();
   static const db_connection & getDBConnection();
   static const dump_active_network & getDumpActiveNetwork();
@@ -40,6 +40,7 @@
 #include "math/CSizeOf.h"
 #include "network/CEdge.h"
 #include "network/CNetwork.h"
+#include "network/CNode.h"
 #include "sets/CSetReference.h"
 #include "sets/CSetList.h"
 #include "traits/CTrait.h"
@@ -84,7 +85,10 @@ std::map< size_t, std::set< const CNode * > > CChanges::RankToNodesRequested;
 size_t CChanges::Tick = std::numeric_limits< size_t >::max();
 
 // static
-CConnection * CConnection::pINSTANCE = NULL;
+CContext< CConnection * > CConnection::Pool = CContext< CConnection * >();
+
+// static
+bool CConnection::shared = true;
 
 // static
 bool CConnection::required = false;
@@ -125,6 +129,9 @@ CComputable::Sequence CDependencyGraph::ComputeOnceSequence;
 // static
 CObservable::ObservableMap CObservable::Observables;
 
+// static
+size_t CNode::SizeOfPid(sizeof(size_t));
+
 // static
 bool CEdge::HasLocationId(false);
 
@@ -176,6 +183,15 @@ int CCommunicate::MPIProcesses(-1);
 // static 
 MPI_Comm * CCommunicate::MPICommunicator(NULL);
 
+// static
+MPI_Comm CCommunicate::MPIHostCommunicator;
+
+// static
+int CCommunicate::MPIHostProcesses(1);
+
+// static
+int * CCommunicate::HostRanks(NULL);
+
 // static 
 CContext< size_t > CCommunicate::ThreadIndex = CContext< size_t >();
 
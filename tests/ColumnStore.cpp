@@ -0,0 +1,92 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <vector>
+
+#include "catch.hpp"
+
+#include "db/CColumnStore.h"
+#include "db/CQuery.h"
+#include "db/CSchema.h"
+#include "db/CFieldValueList.h"
+#include "diseaseModel/CModel.h"
+#include "network/CNetwork.h"
+#include "traits/CTrait.h"
+#include "utilities/CSimConfig.h"
+
+extern std::string getAbsolutePath(const std::string & fileName);
+extern void clearTest();
+
+static std::vector< size_t > ids(const CFieldValueList & list)
+{
+  std::vector< size_t > Ids;
+
+  for (const CValue & Value : list)
+    Ids.push_back(Value.toId());
+
+  return Ids;
+}
+
+TEST_CASE("Column Store", "[EpiHiper]")
+{
+  CSimConfig::init(getAbsolutePath("tests/data/ColumnStore.json"));
+  CLogger::setLogDir(getAbsolutePath("tests/TestRunner"));
+  REQUIRE(CSimConfig::isValid());
+  REQUIRE(CColumnStore::isEnabled());
+
+  CTrait::init();
+
+  CNetwork::init(getAbsolutePath("example/contactNetwork.txt"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CModel::Load(getAbsolutePath("example/diseaseModel.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CNetwork::Context.Master().load();
+
+  CSchema::load(CSimConfig::getPersonTraitDB());
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  // Queries on different fields must not share cached results.
+  CFieldValueList Persons(CValueList::Type::id);
+  REQUIRE(CQuery::all("utopia", "pid", Persons, false));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CFieldValueList Households(CValueList::Type::id);
+  REQUIRE(CQuery::all("utopia", "hid", Households, false));
+
+  std::vector< size_t > ExpectedPersons;
+
+  for (size_t pid = 1; pid <= 19; ++pid)
+    ExpectedPersons.push_back(pid);
+
+  REQUIRE(ids(Persons) == ExpectedPersons);
+  REQUIRE(ids(Households) == std::vector< size_t >({1, 2, 3, 4, 5, 6}));
+
+  // Cached results are returned for the same field.
+  CFieldValueList Cached(CValueList::Type::id);
+  REQUIRE(CQuery::all("utopia", "hid", Cached, false));
+  REQUIRE(ids(Cached) == ids(Households));
+
+  clearTest();
+}
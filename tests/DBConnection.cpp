@@ -0,0 +1,239 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <array>
+#include <sstream>
+#include <vector>
+#include <jansson.h>
+#include <pqxx/pqxx>
+
+#include "catch.hpp"
+
+#include "db/CConnection.h"
+#include "db/CQuery.h"
+#include "db/CSchema.h"
+#include "db/CFieldValue.h"
+#include "db/CFieldValueList.h"
+#include "diseaseModel/CModel.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "traits/CTrait.h"
+#include "utilities/CContext.h"
+#include "utilities/CSimConfig.h"
+
+extern std::string getAbsolutePath(const std::string & fileName);
+extern void clearTest();
+
+static std::string uri()
+{
+  const CSimConfig::db_connection & dbConnection = CSimConfig::getDBConnection();
+
+  std::ostringstream URI;
+  URI << "postgresql://" << dbConnection.user << "@" << dbConnection.host << "/" << dbConnection.name << "?connect_timeout=" << dbConnection.connectionTimeout;
+
+  return URI.str();
+}
+
+// The test requires a PostgreSQL server accepting the default connection of the run parameters.
+static bool haveServer()
+{
+  try
+    {
+      pqxx::connection Connection(uri());
+    }
+
+  catch (...)
+    {
+      return false;
+    }
+
+  return true;
+}
+
+// Execute a statement outside of EpiHiper's connections, e.g., to create test data.
+static bool execute(const std::string & sql)
+{
+  try
+    {
+      pqxx::connection Connection(uri());
+      pqxx::work Work(Connection);
+      Work.exec(sql);
+      Work.commit();
+    }
+
+  catch (...)
+    {
+      return false;
+    }
+
+  return true;
+}
+
+static std::vector< size_t > ids(const CFieldValueList & list)
+{
+  std::vector< size_t > Ids;
+
+  for (const CValue & Value : list)
+    Ids.push_back(Value.toId());
+
+  return Ids;
+}
+
+// The ids of the list within [first, last]
+static std::vector< size_t > ids(const CFieldValueList & list, size_t first, size_t last)
+{
+  std::vector< size_t > Ids;
+
+  for (const CValue & Value : list)
+    if (first <= Value.toId() && Value.toId() <= last)
+      Ids.push_back(Value.toId());
+
+  return Ids;
+}
+
+TEST_CASE("DB Connection", "[EpiHiper]")
+{
+  CSimConfig::init();
+
+  if (!haveServer())
+    {
+      WARN("DB Connection: No PostgreSQL server available, skipping test.");
+      CSimConfig::clear();
+      return;
+    }
+
+  // Threads share a single connection unless dbConnectionPerThread is enabled
+  REQUIRE_FALSE(CSimConfig::getDBConnection().connectionPerThread);
+
+  CConnection::setRequired(true);
+  CConnection::init();
+  REQUIRE_FALSE(CLogger::hasErrors());
+  REQUIRE(CConnection::isShared());
+
+  std::string Quoted = CConnection::quote("person\"Trait");
+  REQUIRE(Quoted == "\"person\"\"Trait\"");
+
+  bool success = true;
+
+#pragma omp parallel reduction(&: success)
+  {
+    success &= (CConnection::quote("person\"Trait") == Quoted);
+
+    pqxx::result Result = CQuery::sql("SELECT 1");
+    success &= (Result.size() == 1 && Result[0][0].as< int >() == 1);
+  }
+
+  REQUIRE(success);
+
+  CConnection::setRequired(false);
+  CConnection::clear();
+  CSimConfig::clear();
+}
+
+TEST_CASE("DB Connection per Thread", "[EpiHiper]")
+{
+  CSimConfig::init(getAbsolutePath("tests/data/DBConnection.json"));
+  CLogger::setLogDir(getAbsolutePath("tests/TestRunner"));
+  REQUIRE(CSimConfig::isValid());
+
+  if (!haveServer())
+    {
+      WARN("DB Connection per Thread: No PostgreSQL server available, skipping test.");
+      CSimConfig::clear();
+      return;
+    }
+
+  REQUIRE(CSimConfig::getDBConnection().connectionPerThread);
+  REQUIRE(CSimConfig::getDBConnection().maxRecords == 2);
+
+  CTrait::init();
+
+  CNetwork::init(getAbsolutePath("example/contactNetwork.txt"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CModel::Load(getAbsolutePath("example/diseaseModel.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CNetwork::Context.Master().load();
+
+  // The table is not temporary since the threads' connections must see it. Rows outside the node range must not be returned.
+  const std::array< size_t, 2 > & Range = CNetwork::Context.Master().getTotalNodeRange();
+  std::ostringstream Create;
+  Create << "DROP TABLE IF EXISTS epihiper_test_paging; ";
+  Create << "CREATE TABLE epihiper_test_paging AS SELECT pid::bigint AS pid, (pid % 3)::integer AS value FROM generate_series(" << Range[0] << ", " << Range[1] + 5 << ") AS pid;";
+
+  if (!execute(Create.str()))
+    {
+      WARN("DB Connection per Thread: Failed to create the test table, skipping test.");
+      clearTest();
+      return;
+    }
+
+  json_error_t Error;
+  json_t * pTable = json_loads("{\"name\": \"epihiper_test_paging\", \"schema\": {\"fields\": [{\"name\": \"pid\", \"type\": \"number\"}, {\"name\": \"value\", \"type\": \"integer\"}], \"primaryKey\": \"pid\"}}", 0, &Error);
+  json_t * pSchema = json_array();
+  json_array_append_new(pSchema, pTable);
+  CSchema::INSTANCE.fromJSON(pSchema);
+  json_decref(pSchema);
+  REQUIRE(CSchema::INSTANCE.getTable("epihiper_test_paging").isValid());
+
+  CConnection::setRequired(true);
+  CConnection::init();
+  REQUIRE_FALSE(CLogger::hasErrors());
+  REQUIRE(CConnection::isShared() == (omp_get_max_threads() == 1));
+
+  // The serial results page through the whole table, i.e., their size must exceed the limit.
+  CFieldValueList All(CValueList::Type::id);
+  REQUIRE(CQuery::all("epihiper_test_paging", "pid", All, false));
+  REQUIRE(All.size() == Range[1] - Range[0] + 1);
+
+  CFieldValueList Where(CValueList::Type::id);
+  REQUIRE(CQuery::where("epihiper_test_paging", "pid", Where, false, "value", CFieldValue(1), "<"));
+  REQUIRE(Where.size() > 2);
+  REQUIRE(Where.size() < All.size());
+
+  bool success = true;
+
+#pragma omp parallel reduction(&: success)
+  {
+    size_t First = CNetwork::Context.Active().beginNode()->id;
+    size_t Last = (CNetwork::Context.Active().endNode() - 1)->id;
+
+    // Each thread queries its own slice through its own connection.
+    CFieldValueList LocalAll(CValueList::Type::id);
+    success &= CQuery::all("epihiper_test_paging", "pid", LocalAll, true);
+    success &= (ids(LocalAll) == ids(All, First, Last));
+
+    CFieldValueList LocalWhere(CValueList::Type::id);
+    success &= CQuery::where("epihiper_test_paging", "pid", LocalWhere, true, "value", CFieldValue(1), "<");
+    success &= (ids(LocalWhere) == ids(Where, First, Last));
+  }
+
+  REQUIRE(success);
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CConnection::setRequired(false);
+  execute("DROP TABLE IF EXISTS epihiper_test_paging;");
+
+  clearTest();
+}
@@ -0,0 +1,95 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <sstream>
+
+#include "catch.hpp"
+#include "network/CEdge.h"
+
+static CEdge createEdge(const size_t & targetId, const size_t & sourceId)
+{
+  CEdge Edge;
+
+  Edge.targetId = targetId;
+  Edge.targetActivity = 3;
+  Edge.sourceId = sourceId;
+  Edge.sourceActivity = 5;
+  Edge.duration = 1234.5;
+  Edge.edgeTrait = 7;
+  Edge.active = false;
+  Edge.weight = 0.25;
+
+  return Edge;
+}
+
+static void requireEqual(const CEdge & edge, const CEdge & expected)
+{
+  REQUIRE(edge.targetId == expected.targetId);
+  REQUIRE(edge.targetActivity == expected.targetActivity);
+  REQUIRE(edge.sourceId == expected.sourceId);
+  REQUIRE(edge.sourceActivity == expected.sourceActivity);
+  REQUIRE(edge.duration == expected.duration);
+  REQUIRE(edge.edgeTrait == expected.edgeTrait);
+  REQUIRE(edge.active == expected.active);
+  REQUIRE(edge.weight == expected.weight);
+}
+
+TEST_CASE("EdgeBinary", "[EpiHiper]")
+{
+  SECTION("4 byte person ids")
+  {
+    CEdge Expected = createEdge(4000000000, 17);
+    std::stringstream Binary;
+
+    Expected.toBinary(Binary, 4);
+    Expected.toBinary(Binary, 4);
+
+    std::stringstream Legacy;
+    Expected.toBinary(Legacy, 8);
+
+    REQUIRE(Binary.str().size() / 2 < Legacy.str().size());
+
+    CEdge Edge;
+    Edge.fromBinary(Binary, 4);
+    REQUIRE(Binary.good());
+    requireEqual(Edge, Expected);
+
+    Edge = CEdge();
+    Edge.fromBinary(Binary, 4);
+    REQUIRE(Binary.good());
+    requireEqual(Edge, Expected);
+  }
+
+  SECTION("8 byte person ids")
+  {
+    CEdge Expected = createEdge(17, 5000000000);
+    std::stringstream Binary;
+
+    Expected.toBinary(Binary, 8);
+
+    CEdge Edge;
+    Edge.fromBinary(Binary, 8);
+    REQUIRE(Binary.good());
+    requireEqual(Edge, Expected);
+  }
+}
@@ -0,0 +1,95 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <vector>
+
+#include "catch.hpp"
+
+#include "utilities/CGuideTable.h"
+
+// The linear scan formerly used for sampling progressions and discrete distributions
+static size_t linearScan(const std::vector< double > & propensities, double alpha)
+{
+  for (size_t i = 0; i < propensities.size(); ++i)
+    {
+      alpha -= propensities[i];
+
+      if (alpha < 0.0)
+        return i;
+    }
+
+  return propensities.size() - 1;
+}
+
+// The propensities are multiples of 1/8 and alpha multiples of 1/64 so that all sums are exact and
+// the boundaries between the items are probed.
+static void compare(const std::vector< double > & propensities)
+{
+  CGuideTable Table;
+  Table.init(propensities);
+
+  REQUIRE_FALSE(Table.empty());
+
+  double Total = 0.0;
+
+  for (const double & Propensity : propensities)
+    Total += Propensity;
+
+  REQUIRE(Table.total() == Total);
+
+  for (double Alpha = 0.0; Alpha < Total; Alpha += 1.0 / 64.0)
+    REQUIRE(Table.index(Alpha) == linearScan(propensities, Alpha));
+
+  REQUIRE(Table.index(Total) == linearScan(propensities, Total));
+}
+
+TEST_CASE("GuideTable", "[EpiHiper]")
+{
+  SECTION("uniform")
+  {
+    compare(std::vector< double >(10, 0.5));
+    compare(std::vector< double >(1, 2.0));
+  }
+
+  SECTION("skewed")
+  {
+    compare({0.125, 4.0, 0.25, 0.125, 1.0, 0.375});
+    compare({8.0, 0.125, 0.125});
+  }
+
+  SECTION("zero propensity")
+  {
+    compare({0.0, 1.0, 0.0, 0.0, 0.5, 0.0});
+    compare({0.0, 0.0, 3.0});
+    compare({2.0, 0.0, 0.0});
+    compare({0.0, 0.0, 0.0});
+  }
+
+  SECTION("empty")
+  {
+    CGuideTable Table;
+    Table.init(std::vector< double >());
+
+    REQUIRE(Table.empty());
+  }
+}
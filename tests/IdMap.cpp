@@ -0,0 +1,119 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <map>
+
+#include "catch.hpp"
+
+#include "utilities/CIdMap.h"
+
+TEST_CASE("IdMap", "[EpiHiper]")
+{
+  std::vector< int > Values(5000, 0);
+
+  SECTION("growth")
+  {
+    // Starting from an empty map all entries are preserved when the table is rehashed.
+    CIdMap< int > Map;
+    Map.init(0);
+
+    REQUIRE(Map.find(0) == NULL);
+
+    for (size_t i = 0; i < Values.size(); ++i)
+      {
+        Map.insert(3 * i + 1, &Values[i]);
+        REQUIRE(Map.size() == i + 1);
+      }
+
+    for (size_t i = 0; i < Values.size(); ++i)
+      {
+        REQUIRE(Map.find(3 * i + 1) == &Values[i]);
+        REQUIRE(Map.find(3 * i) == NULL);
+        REQUIRE(Map.find(3 * i + 2) == NULL);
+      }
+  }
+
+  SECTION("collisions")
+  {
+    // With room for 64 entries the table has 128 slots, i.e., the slot is given by the 7 high bits of the
+    // Fibonacci hash. Ids hashing to the same slot form a single probe sequence.
+    CIdMap< int > Map;
+    Map.init(64);
+    std::map< size_t, int * > Expected;
+    std::vector< size_t > Colliding;
+
+    for (size_t Id = 0; Colliding.size() < 40; ++Id)
+      if (((Id * 0x9E3779B97F4A7C15ULL) >> 57) == 5)
+        Colliding.push_back(Id);
+
+    for (size_t i = 0; i < 32; ++i)
+      {
+        Map.insert(Colliding[i], &Values[i]);
+        Expected[Colliding[i]] = &Values[i];
+      }
+
+    // Ids hashing to the slots occupied by the probe sequence
+    for (size_t Id = 0; Expected.size() < 64; ++Id)
+      if (Expected.find(Id) == Expected.end()
+          && ((Id * 0x9E3779B97F4A7C15ULL) >> 57) > 5
+          && ((Id * 0x9E3779B97F4A7C15ULL) >> 57) < 40)
+        {
+          int * pValue = &Values[Expected.size()];
+          Map.insert(Id, pValue);
+          Expected[Id] = pValue;
+        }
+
+    REQUIRE(Map.size() == Expected.size());
+
+    for (const std::pair< const size_t, int * > & Entry : Expected)
+      REQUIRE(Map.find(Entry.first) == Entry.second);
+
+    // Missing ids must be found absent even though their probe sequence passes occupied slots
+    for (size_t i = 32; i < Colliding.size(); ++i)
+      REQUIRE(Map.find(Colliding[i]) == NULL);
+  }
+
+  SECTION("update")
+  {
+    CIdMap< int > Map;
+    Map.init(2);
+
+    Map.insert(7, &Values[0]);
+    Map.insert(7, &Values[1]);
+
+    REQUIRE(Map.size() == 1);
+    REQUIRE(Map.find(7) == &Values[1]);
+  }
+
+  SECTION("missing")
+  {
+    CIdMap< int > Map;
+
+    REQUIRE(Map.size() == 0);
+    REQUIRE(Map.find(0) == NULL);
+    REQUIRE(Map.find(12345) == NULL);
+
+    Map.init(10);
+    REQUIRE(Map.find(0) == NULL);
+  }
+}
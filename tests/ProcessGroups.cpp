@@ -0,0 +1,113 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <set>
+
+#include "catch.hpp"
+
+#include "utilities/CLogger.h"
+#include "diseaseModel/CModel.h"
+#include "intervention/CIntervention.h"
+#include "intervention/CTrigger.h"
+#include "actions/CActionQueue.h"
+#include "actions/CChanges.h"
+#include "math/CDependencyGraph.h"
+#include "sets/CSetReference.h"
+#include "network/CNetwork.h"
+#include "traits/CTrait.h"
+#include "utilities/CSimConfig.h"
+#include "variables/CVariableList.h"
+
+extern std::string getAbsolutePath(const std::string & fileName);
+extern void clearTest();
+
+TEST_CASE("Process Groups", "[EpiHiper]")
+{
+  CSimConfig::init();
+  CTrait::init();
+  CLogger::info("Starting Test: Process Groups");
+
+  CNetwork::init(getAbsolutePath("example/contactNetwork.txt"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CModel::Load(getAbsolutePath("example/diseaseModel.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CIntervention::load(getAbsolutePath("tests/data/ProcessGroups.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  REQUIRE(CSetReference::resolve());
+  REQUIRE(CCommunicate::allocateRMA() == (int) CCommunicate::ErrorCode::Success);
+
+  CNetwork::Context.Master().load();
+
+  CActionQueue::init(0);
+  CChanges::setCurrentTick(0);
+  CLogger::updateTick();
+  CDependencyGraph::buildGraph();
+  CModel::UpdateGlobalStateCounts();
+
+#ifdef USE_PROCESS_GROUPS
+  // The prerequisites of each computable must be computed in an earlier process group.
+  CDependencyGraph::UpdateOrder UpdateOrder;
+  REQUIRE(CDependencyGraph::getUpdateOrder(UpdateOrder, CComputable::Instances));
+  REQUIRE_FALSE(UpdateOrder.empty());
+
+  std::set< const CComputable * > Ordered;
+
+  for (const CComputable::Sequence & group : UpdateOrder)
+    Ordered.insert(group.begin(), group.end());
+
+  std::set< const CComputable * > Computed;
+
+  for (const CComputable::Sequence & group : UpdateOrder)
+    {
+      for (const CComputable * pComputable : group)
+        for (const std::pair< const size_t, const CComputable * > & prerequisite : pComputable->getPrerequisites())
+          if (Ordered.count(prerequisite.second))
+            REQUIRE(Computed.count(prerequisite.second));
+
+      Computed.insert(group.begin(), group.end());
+    }
+#endif
+
+  bool success = true;
+
+#pragma omp parallel reduction(&: success)
+  {
+    CVariableList::INSTANCE.resetAll(true);
+
+    success &= CDependencyGraph::applyComputeOnceOrder();
+    success &= CDependencyGraph::applyUpdateOrder();
+    success &= CTrigger::processAll();
+    success &= CIntervention::processAll();
+    success &= CActionQueue::processCurrentActions();
+
+    CVariableList::INSTANCE.synchronizeChangedVariables();
+  }
+
+  REQUIRE(success);
+  REQUIRE(CVariableList::INSTANCE["triggered"].toValue().toNumber() == 1111);
+
+  clearTest();
+}
@@ -0,0 +1,145 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+#include "catch.hpp"
+
+#include "sets/CSetBitmap.h"
+
+typedef CSetBitmap< int > Bitmap;
+
+// A sorted random subset of the elements where each element is selected with the given probability
+static Bitmap::sorted_vector randomSubset(std::vector< int > & elements, const double & probability, std::mt19937 & generator)
+{
+  std::bernoulli_distribution Select(probability);
+  Bitmap::sorted_vector Subset;
+
+  for (int & Element : elements)
+    if (Select(generator))
+      Subset.push_back(&Element);
+
+  return Subset;
+}
+
+static void compare(const std::vector< Bitmap::sorted_vector > & sets, int * pBegin, int * pEnd)
+{
+  Bitmap::operands Operands;
+
+  for (const Bitmap::sorted_vector & Set : sets)
+    Operands.push_back(&Set);
+
+  Bitmap::sorted_vector Expected;
+  Bitmap::sorted_vector Tmp;
+  Bitmap::sorted_vector Result;
+
+  Expected = sets.front();
+
+  for (size_t i = 1; i < sets.size(); ++i)
+    {
+      Tmp.clear();
+      std::set_union(Expected.begin(), Expected.end(), sets[i].begin(), sets[i].end(), std::back_inserter(Tmp));
+      Expected.swap(Tmp);
+    }
+
+  Bitmap::unite(Operands, pBegin, pEnd, Result);
+  REQUIRE(Result == Expected);
+
+  Expected = sets.front();
+
+  for (size_t i = 1; i < sets.size(); ++i)
+    {
+      Tmp.clear();
+      std::set_intersection(Expected.begin(), Expected.end(), sets[i].begin(), sets[i].end(), std::back_inserter(Tmp));
+      Expected.swap(Tmp);
+    }
+
+  Bitmap::intersect(Operands, pBegin, pEnd, Result);
+  REQUIRE(Result == Expected);
+}
+
+TEST_CASE("SetBitmap", "[EpiHiper]")
+{
+  // The bitmap covers the elements [100, 900) and the remaining elements are outside.
+  std::vector< int > Elements(1000, 0);
+  int * pBegin = Elements.data() + 100;
+  int * pEnd = Elements.data() + 900;
+  std::mt19937 Generator(42);
+
+  SECTION("dense")
+  {
+    for (const double & Probability : {0.9, 0.5, 0.1})
+      {
+        std::vector< Bitmap::sorted_vector > Sets;
+
+        for (int i = 0; i < 3; ++i)
+          Sets.push_back(randomSubset(Elements, Probability, Generator));
+
+        REQUIRE(Bitmap::isDense(Sets.front().size(), pBegin, pEnd));
+        compare(Sets, pBegin, pEnd);
+      }
+  }
+
+  SECTION("sparse")
+  {
+    std::vector< Bitmap::sorted_vector > Sets;
+
+    for (int i = 0; i < 3; ++i)
+      Sets.push_back(randomSubset(Elements, 0.005, Generator));
+
+    Sets.push_back(Bitmap::sorted_vector());
+
+    REQUIRE_FALSE(Bitmap::isDense(Sets.back().size(), pBegin, pEnd));
+    compare(Sets, pBegin, pEnd);
+  }
+
+  SECTION("mixed")
+  {
+    // A dense operand combined with a sparse one and with one entirely outside of the bitmap
+    std::vector< Bitmap::sorted_vector > Sets;
+    Sets.push_back(randomSubset(Elements, 0.7, Generator));
+    Sets.push_back(randomSubset(Elements, 0.01, Generator));
+
+    Bitmap::sorted_vector Outside;
+
+    for (size_t i = 0; i < 100; i += 7)
+      Outside.push_back(&Elements[i]);
+
+    for (size_t i = 900; i < Elements.size(); i += 9)
+      Outside.push_back(&Elements[i]);
+
+    Sets.push_back(Outside);
+
+    compare(Sets, pBegin, pEnd);
+    compare(std::vector< Bitmap::sorted_vector >({Sets[0], Sets[2]}), pBegin, pEnd);
+  }
+
+  SECTION("single element")
+  {
+    Bitmap::sorted_vector Single(1, pBegin + 63);
+    compare(std::vector< Bitmap::sorted_vector >({Single, Single}), pBegin, pBegin + 64);
+    compare(std::vector< Bitmap::sorted_vector >({Single}), pBegin + 63, pBegin + 64);
+  }
+}
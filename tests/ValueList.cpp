@@ -0,0 +1,146 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2026 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <sstream>
+
+#include "catch.hpp"
+
+#include "math/CValueList.h"
+
+// The list read from its binary representation is indexed, whereas the appended list uses the set lookup.
+static void compareLookup(const CValueList & appended, const std::vector< CValue > & probes)
+{
+  std::stringstream Binary;
+  appended.toBinary(Binary);
+  CValueList Indexed(Binary);
+
+  REQUIRE(Indexed.size() == appended.size());
+
+  for (const CValue & Probe : probes)
+    REQUIRE(Indexed.contains(Probe) == appended.contains(Probe));
+}
+
+TEST_CASE("ValueList", "[EpiHiper]")
+{
+  SECTION("boolean")
+  {
+    CValueList List(CValueList::Type::boolean);
+    List.append(CValue(true));
+
+    compareLookup(List, {CValue(true), CValue(false), CValue(1.0), CValue((size_t) 1)});
+  }
+
+  SECTION("id")
+  {
+    CValueList Small(CValueList::Type::id);
+    CValueList Large(CValueList::Type::id);
+    std::vector< CValue > Probes;
+
+    for (size_t id = 0; id < 200; id += 3)
+      {
+        if (id < 64)
+          Small.append(CValue(id));
+
+        Large.append(CValue(id));
+      }
+
+    for (size_t id = 0; id < 210; ++id)
+      Probes.push_back(CValue(id));
+
+    Probes.push_back(CValue(3.0));
+    Probes.push_back(CValue((int) 3));
+
+    compareLookup(Small, Probes);
+    compareLookup(Large, Probes);
+  }
+
+  SECTION("number and integer")
+  {
+    CValueList Numbers(CValueList::Type::number);
+    CValueList Integers(CValueList::Type::integer);
+    std::vector< CValue > Probes;
+
+    for (int i = -5; i < 20; i += 2)
+      {
+        Numbers.append(CValue((double) i));
+        Numbers.append(CValue(i + 0.5));
+        Integers.append(CValue(i));
+      }
+
+    for (int i = -6; i < 21; ++i)
+      {
+        Probes.push_back(CValue(i));
+        Probes.push_back(CValue((double) i));
+        Probes.push_back(CValue(i + 0.5));
+      }
+
+    compareLookup(Numbers, Probes);
+    compareLookup(Integers, Probes);
+  }
+
+  SECTION("trait value")
+  {
+    // A feature occupying bits 4 to 7 and another one occupying bits 8 to 9
+    CTraitData::base Feature = 0xF0;
+    CTraitData::base Other = 0x300;
+
+    CValueList List(CValueList::Type::traitValue);
+    List.append(CValue(CTraitData::value(Feature, 0x10)));
+    List.append(CValue(CTraitData::value(Feature, 0x30)));
+    List.append(CValue(CTraitData::value(Feature, 0xF0)));
+
+    std::vector< CValue > Probes;
+
+    for (CTraitData::base Value = 0; Value < 0x400; Value += 0x10)
+      {
+        Probes.push_back(CValue(CTraitData::value(Feature, Value)));
+        Probes.push_back(CValue(CTraitData::value(Other, Value)));
+        Probes.push_back(CValue(Value));
+        Probes.push_back(CValue((CTraitData::base) (Value | 0x5)));
+      }
+
+    compareLookup(List, Probes);
+  }
+
+  SECTION("modification")
+  {
+    CValueList List(CValueList::Type::id);
+    List.append(CValue((size_t) 1));
+
+    std::stringstream Binary;
+    List.toBinary(Binary);
+    CValueList Indexed(Binary);
+
+    std::vector< CValue > More = {CValue((size_t) 2), CValue((size_t) 100)};
+    Indexed.insert(More.begin(), More.end());
+    REQUIRE(Indexed.contains(CValue((size_t) 2)));
+    REQUIRE(Indexed.contains(CValue((size_t) 100)));
+
+    Indexed.erase(CValue((size_t) 1));
+    REQUIRE_FALSE(Indexed.contains(CValue((size_t) 1)));
+
+    Indexed.clear();
+    REQUIRE_FALSE(Indexed.contains(CValue((size_t) 2)));
+  }
+}